@@ -0,0 +1,600 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <LinkedList.hpp>
+#include <ListBatch.hpp>
+#include <LruCache.hpp>
+
+// Built with the release flags whatever the configuration is: the numbers only mean something with optimizations on.
+// Usage: ListBench [traversal|lru|batch]; no argument runs everything
+namespace {
+    const size_t BENCH_LIST_SIZE = 1 << 21;
+    const size_t BENCH_REPEATS   = 5;
+    const size_t NODE_WORK_STEPS = 64;
+
+    const size_t LRU_CAPACITY    = 1 << 16;
+    const size_t LRU_KEYS        = 1 << 20;
+    const size_t LRU_REQUESTS    = 1 << 22;
+    const double LRU_KEYS_SKEW   = 4; // key = LRU_KEYS * u^skew: higher skew means a hotter head
+
+    const size_t BATCH_SIZE          = 4096;
+    const size_t BATCH_ROUNDS        = 200;
+    const size_t BATCH_CHECK_ROUNDS  = 2000;
+    const size_t BATCH_CHECK_NODES   = 64;
+
+    using BenchClock = std::chrono::steady_clock;
+
+    double ElapsedNs (BenchClock::time_point start) {
+        return std::chrono::duration <double, std::nano> (BenchClock::now () - start).count ();
+    }
+
+    // Every node goes after a random existing one, so the logical order is a random walk over the arrays.
+    // Returns the created nodes
+    std::vector <ssize_t> BuildShuffledList (LinkedList::List <double> *list, size_t size, size_t capacity, std::mt19937_64 *random) {
+        LinkedList::InitList (list, capacity);
+
+        std::vector <ssize_t> nodes = {0};
+        nodes.reserve (size + 1);
+
+        for (size_t nodeNumber = 0; nodeNumber < size; nodeNumber++) {
+            ssize_t newIndex = 0;
+            LinkedList::InsertAfter (list, nodes [(*random) () % nodes.size ()], &newIndex, (double) nodeNumber);
+            nodes.push_back (newIndex);
+        }
+
+        nodes.erase (nodes.begin ());
+
+        return nodes;
+    }
+
+    // Stands for real per-node processing: a dependent chain of about as many cycles as a cache miss costs
+    inline double NodeWork (double element) {
+        double value = element;
+
+        for (size_t step = 0; step < NODE_WORK_STEPS; step++) {
+            value = value * 0.999 + 0.5;
+        }
+
+        return value;
+    }
+
+    inline double NoNodeWork (double element) {
+        return element;
+    }
+
+    template <double (*nodeWork) (double)>
+    double PlainTraversalNs (LinkedList::List <double> *list, double *sum) {
+        BenchClock::time_point start = BenchClock::now ();
+
+        for (double element : *list) {
+            *sum += nodeWork (element);
+        }
+
+        return ElapsedNs (start);
+    }
+
+    template <double (*nodeWork) (double), size_t PREFETCH_DISTANCE>
+    double PrefetchingTraversalNs (LinkedList::List <double> *list, double *sum) {
+        BenchClock::time_point start = BenchClock::now ();
+
+        for (double element : LinkedList::PrefetchingTraversal <PREFETCH_DISTANCE> (list)) {
+            *sum += nodeWork (element);
+        }
+
+        return ElapsedNs (start);
+    }
+
+    // Best of BENCH_REPEATS runs in ns per node
+    template <typename traversal_t>
+    double BestTraversalNs (LinkedList::List <double> *list, traversal_t traversal) {
+        double best = 0;
+        double sum  = 0;
+
+        for (size_t repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+            double elapsed = traversal (list, &sum) / (double) BENCH_LIST_SIZE;
+            best = repeat == 0 ? elapsed : std::min (best, elapsed);
+        }
+
+        if (sum < 0) {
+            printf ("impossible sum %lf\n", sum);
+        }
+
+        return best;
+    }
+
+    template <double (*nodeWork) (double), size_t PREFETCH_DISTANCE>
+    void ReportPrefetchingTraversal (LinkedList::List <double> *list, double plainNs) {
+        double prefetchingNs = BestTraversalNs (list, PrefetchingTraversalNs <nodeWork, PREFETCH_DISTANCE>);
+
+        printf ("  prefetch distance %2zu: %6.2lf ns/node (%.2lfx)%s\n", PREFETCH_DISTANCE, prefetchingNs, plainNs / prefetchingNs,
+                PREFETCH_DISTANCE == LinkedList::DEFAULT_PREFETCH_DISTANCE ? " <- default" : "");
+    }
+
+    template <double (*nodeWork) (double)>
+    void ReportTraversals (LinkedList::List <double> *list, const char *workName) {
+        double plainNs = BestTraversalNs (list, PlainTraversalNs <nodeWork>);
+
+        printf ("traversal of a shuffled list of %zu nodes, %s\n", BENCH_LIST_SIZE, workName);
+        printf ("  plain iterator:       %6.2lf ns/node\n", plainNs);
+
+        ReportPrefetchingTraversal <nodeWork, 1>  (list, plainNs);
+        ReportPrefetchingTraversal <nodeWork, 2>  (list, plainNs);
+        ReportPrefetchingTraversal <nodeWork, 4>  (list, plainNs);
+        ReportPrefetchingTraversal <nodeWork, 8>  (list, plainNs);
+        ReportPrefetchingTraversal <nodeWork, 16> (list, plainNs);
+        ReportPrefetchingTraversal <nodeWork, 32> (list, plainNs);
+    }
+
+    void BenchTraversal () {
+        std::mt19937_64 random (1);
+
+        LinkedList::List <double> list = {};
+        BuildShuffledList (&list, BENCH_LIST_SIZE, BENCH_LIST_SIZE, &random);
+
+        ReportTraversals <NoNodeWork> (&list, "empty loop body");
+        ReportTraversals <NodeWork>   (&list, "per-node work");
+
+        LinkedList::DestroyList (&list);
+    }
+
+    // Read-through use: every miss is followed by a Put of the same key
+    std::vector <uint64_t> MakeLruRequests (size_t requestsCount, uint64_t seed) {
+        std::mt19937_64                         random       (seed);
+        std::uniform_real_distribution <double> distribution (0, 1);
+        std::vector <uint64_t>                  requests     (requestsCount);
+
+        for (uint64_t &key : requests) {
+            key = (uint64_t) (std::pow (distribution (random), LRU_KEYS_SKEW) * (double) LRU_KEYS);
+        }
+
+        return requests;
+    }
+
+    void BenchLruCache () {
+        std::vector <uint64_t> requests = MakeLruRequests (LRU_REQUESTS, 2);
+
+        LinkedList::LruCache <uint64_t, uint64_t> cache = {};
+        LinkedList::InitLruCache (&cache, LRU_CAPACITY);
+
+        BenchClock::time_point start = BenchClock::now ();
+
+        for (uint64_t key : requests) {
+            uint64_t *value = NULL;
+            LinkedList::LruCacheGet (&cache, key, &value);
+
+            if (!value) {
+                LinkedList::LruCachePut (&cache, key, key);
+            }
+        }
+
+        double elapsed = ElapsedNs (start);
+
+        printf ("lru cache of %zu entries, %zu requests over %zu keys\n", LRU_CAPACITY, LRU_REQUESTS, LRU_KEYS);
+        printf ("  single cache:  hit rate %5.2lf%%, %6.2lf Mrequests/s, %zu evictions\n",
+                100.0 * (double) cache.hits / (double) LRU_REQUESTS, (double) LRU_REQUESTS * 1e3 / elapsed, cache.evictions);
+
+        LinkedList::DestroyLruCache (&cache);
+
+        // Same request count split over the threads, each with its own stream
+        size_t threadsCount = std::max (1u, std::thread::hardware_concurrency ());
+
+        auto *shardedCache = new LinkedList::ShardedLruCache <uint64_t, uint64_t> ();
+        LinkedList::InitShardedLruCache (shardedCache, LRU_CAPACITY);
+
+        std::vector <std::vector <uint64_t>> threadRequests (threadsCount);
+
+        for (size_t threadIndex = 0; threadIndex < threadsCount; threadIndex++) {
+            threadRequests [threadIndex] = MakeLruRequests (LRU_REQUESTS / threadsCount, 3 + threadIndex);
+        }
+
+        std::vector <size_t>      threadHits (threadsCount);
+        std::vector <std::thread> threads    = {};
+
+        start = BenchClock::now ();
+
+        for (size_t threadIndex = 0; threadIndex < threadsCount; threadIndex++) {
+            threads.emplace_back ([shardedCache, &threadRequests, &threadHits, threadIndex] () {
+                for (uint64_t key : threadRequests [threadIndex]) {
+                    uint64_t value   = 0;
+                    bool     isFound = false;
+                    LinkedList::ShardedLruCacheGet (shardedCache, key, &value, &isFound);
+
+                    if (isFound) {
+                        threadHits [threadIndex]++;
+                    } else {
+                        LinkedList::ShardedLruCachePut (shardedCache, key, key);
+                    }
+                }
+            });
+        }
+
+        for (std::thread &thread : threads) {
+            thread.join ();
+        }
+
+        elapsed = ElapsedNs (start);
+
+        size_t hits          = 0;
+        size_t requestsCount = threadsCount * (LRU_REQUESTS / threadsCount);
+
+        for (size_t threadHitsCount : threadHits) {
+            hits += threadHitsCount;
+        }
+
+        printf ("  sharded cache: hit rate %5.2lf%%, %6.2lf Mrequests/s on %zu threads\n",
+                100.0 * (double) hits / (double) requestsCount, (double) requestsCount * 1e3 / elapsed, threadsCount);
+
+        LinkedList::DestroyShardedLruCache (shardedCache);
+        delete shardedCache;
+    }
+
+    struct BenchOperation {
+        LinkedList::BatchOperationType type   = LinkedList::BATCH_INSERT_AFTER;
+        ssize_t                        target = 0;
+    };
+
+    // Seven inserts after and three deletes of random live nodes out of ten; deleted nodes leave liveNodes
+    std::vector <BenchOperation> MakeBatchOperations (std::vector <ssize_t> *liveNodes, std::mt19937_64 *random) {
+        std::vector <BenchOperation> operations (BATCH_SIZE);
+
+        for (BenchOperation &operation : operations) {
+            size_t nodePosition = (*random) () % liveNodes->size ();
+
+            operation.target = (*liveNodes) [nodePosition];
+
+            if ((*random) () % 10 < 3) {
+                operation.type = LinkedList::BATCH_DELETE;
+
+                (*liveNodes) [nodePosition] = liveNodes->back ();
+                liveNodes->pop_back ();
+            }
+        }
+
+        return operations;
+    }
+
+    bool IsSameList (const LinkedList::List <double> *first, const LinkedList::List <double> *second) {
+        if (first->capacity != second->capacity || first->freeElem != second->freeElem) {
+            return false;
+        }
+
+        for (ssize_t nodeIndex = 0; nodeIndex < first->capacity; nodeIndex++) {
+            if (first->next [nodeIndex] != second->next [nodeIndex] || first->prev [nodeIndex] != second->prev [nodeIndex]) {
+                return false;
+            }
+
+            if (nodeIndex != 0 && first->prev [nodeIndex] != -1 && memcmp (first->data + nodeIndex, second->data + nodeIndex, sizeof (double)) != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Grouped batches keep the node order and contents but not the indices, so this walks both lists from the head
+    bool IsSameOrder (const LinkedList::List <double> *first, const LinkedList::List <double> *second) {
+        ssize_t firstNode  = first->next  [0];
+        ssize_t secondNode = second->next [0];
+
+        for (ssize_t hops = 0; hops < first->capacity && firstNode != 0 && secondNode != 0; hops++) {
+            if (memcmp (first->data + firstNode, second->data + secondNode, sizeof (double)) != 0) {
+                return false;
+            }
+
+            firstNode  = first->next  [firstNode];
+            secondNode = second->next [secondNode];
+        }
+
+        return firstNode == 0 && secondNode == 0;
+    }
+
+    // Random batches on a full list of BATCH_CHECK_NODES nodes: deletes, inserts, placeholders and bad targets
+    // mixed, ApplyBatch against InsertAfter and DeleteValue called one by one. Returns the number of mismatches
+    size_t CheckBatchAgainstSequentialCalls () {
+        std::mt19937_64 random (4);
+
+        size_t mismatches = 0;
+
+        for (size_t round = 0; round < BATCH_CHECK_ROUNDS; round++) {
+            uint64_t listSeed = random ();
+
+            std::mt19937_64 batchListRandom      (listSeed);
+            std::mt19937_64 sequentialListRandom (listSeed);
+
+            LinkedList::List <double> batchList      = {};
+            LinkedList::List <double> sequentialList = {};
+
+            BuildShuffledList (&batchList,      BATCH_CHECK_NODES, BATCH_CHECK_NODES, &batchListRandom);
+            BuildShuffledList (&sequentialList, BATCH_CHECK_NODES, BATCH_CHECK_NODES, &sequentialListRandom);
+
+            LinkedList::ListBatch <double> batch = {};
+            LinkedList::InitBatch (&batch, 0);
+
+            std::vector <ssize_t> sequentialResults = {};
+            size_t                operationsCount   = 1 + random () % (2 * BATCH_CHECK_NODES);
+
+            for (size_t operationIndex = 0; operationIndex < operationsCount; operationIndex++) {
+                bool    isDelete = random () % 2 == 0;
+                ssize_t target   = (ssize_t) (random () % (BATCH_CHECK_NODES + 3));
+
+                // Half of the operations aim at a node created (or not) earlier in the batch
+                if (operationIndex > 0 && random () % 2 == 0) {
+                    target = LinkedList::BatchPlaceholder (random () % operationIndex);
+                }
+
+                double element = (double) operationIndex;
+
+                if (isDelete) {
+                    LinkedList::BatchDelete (&batch, target, NULL);
+                } else {
+                    LinkedList::BatchInsertAfter (&batch, target, element, NULL);
+                }
+
+                ssize_t resolvedTarget = target;
+
+                if (target < 0) {
+                    size_t creatorIndex = (size_t) (-1 - target);
+
+                    resolvedTarget = batch.operations [creatorIndex].type == LinkedList::BATCH_INSERT_AFTER ?
+                                         sequentialResults [creatorIndex] : LinkedList::BATCH_SKIPPED;
+                }
+
+                ssize_t                   result    = LinkedList::BATCH_SKIPPED;
+                LinkedList::ListErrorCode errorCode = LinkedList::WRONG_INDEX;
+
+                if (resolvedTarget >= 0 && resolvedTarget < sequentialList.capacity) {
+                    errorCode = isDelete ? LinkedList::DeleteValue (&sequentialList, resolvedTarget) :
+                                           LinkedList::InsertAfter (&sequentialList, resolvedTarget, &result, element);
+                }
+
+                if (errorCode == LinkedList::NO_LIST_ERRORS) {
+                    result = isDelete ? resolvedTarget : result;
+                } else {
+                    result = LinkedList::BATCH_SKIPPED;
+                }
+
+                sequentialResults.push_back (result);
+            }
+
+            LinkedList::ApplyBatch (&batchList, &batch);
+
+            bool isSame = IsSameList (&batchList, &sequentialList);
+
+            for (size_t operationIndex = 0; operationIndex < operationsCount; operationIndex++) {
+                isSame = isSame && LinkedList::BatchResult (&batch, operationIndex) == sequentialResults [operationIndex];
+            }
+
+            mismatches += isSame ? 0 : 1;
+
+            LinkedList::DestroyBatch (&batch);
+            LinkedList::DestroyList  (&batchList);
+            LinkedList::DestroyList  (&sequentialList);
+        }
+
+        return mismatches;
+    }
+
+    // Same mix through ApplyBatchGrouped on a list with room for every insert, so the operations do get grouped. One by one calls skip what
+    // the grouped run skips: targets that were not live before the batch and nodes the batch has already deleted.
+    // Compares the node order, the contents and which operations were applied
+    size_t CheckGroupedBatchAgainstSequentialCalls () {
+        std::mt19937_64 random (7);
+
+        size_t mismatches = 0;
+
+        for (size_t round = 0; round < BATCH_CHECK_ROUNDS; round++) {
+            uint64_t listSeed = random ();
+
+            std::mt19937_64 batchListRandom      (listSeed);
+            std::mt19937_64 sequentialListRandom (listSeed);
+
+            LinkedList::List <double> batchList      = {};
+            LinkedList::List <double> sequentialList = {};
+
+            BuildShuffledList (&batchList,      BATCH_CHECK_NODES, 3 * BATCH_CHECK_NODES, &batchListRandom);
+            BuildShuffledList (&sequentialList, BATCH_CHECK_NODES, 3 * BATCH_CHECK_NODES, &sequentialListRandom);
+
+            LinkedList::ListBatch <double> batch = {};
+            LinkedList::InitBatch (&batch, 0);
+
+            size_t operationsCount = 1 + random () % (2 * BATCH_CHECK_NODES);
+
+            std::vector <bool>    isLiveBefore      (sequentialList.capacity);
+            std::vector <bool>    isDeletedNode     (sequentialList.capacity);
+            std::vector <bool>    isDeletedCreated  (operationsCount);
+            std::vector <ssize_t> sequentialResults = {};
+
+            for (ssize_t nodeIndex = 0; nodeIndex < sequentialList.capacity; nodeIndex++) {
+                isLiveBefore [nodeIndex] = sequentialList.prev [nodeIndex] != -1;
+            }
+
+            for (size_t operationIndex = 0; operationIndex < operationsCount; operationIndex++) {
+                bool    isDelete = random () % 3 == 0;
+                ssize_t target   = (ssize_t) (random () % (sequentialList.capacity + 3));
+
+                if (operationIndex > 0 && random () % 3 == 0) {
+                    target = LinkedList::BatchPlaceholder (random () % operationIndex);
+                }
+
+                double element = (double) (1000 + operationIndex);
+
+                if (isDelete) {
+                    LinkedList::BatchDelete (&batch, target, NULL);
+                } else {
+                    LinkedList::BatchInsertAfter (&batch, target, element, NULL);
+                }
+
+                ssize_t resolvedTarget = LinkedList::BATCH_SKIPPED;
+                size_t  creatorIndex   = (size_t) (-1 - target);
+
+                if (target >= 0 && target < sequentialList.capacity && isLiveBefore [target] && !isDeletedNode [target]) {
+                    resolvedTarget = target;
+                } else if (target < 0 && batch.operations [creatorIndex].type == LinkedList::BATCH_INSERT_AFTER &&
+                           !isDeletedCreated [creatorIndex]) {
+                    resolvedTarget = sequentialResults [creatorIndex];
+                }
+
+                ssize_t                   result    = LinkedList::BATCH_SKIPPED;
+                LinkedList::ListErrorCode errorCode = LinkedList::WRONG_INDEX;
+
+                if (resolvedTarget >= 0) {
+                    errorCode = isDelete ? LinkedList::DeleteValue (&sequentialList, resolvedTarget) :
+                                           LinkedList::InsertAfter (&sequentialList, resolvedTarget, &result, element);
+                }
+
+                if (errorCode == LinkedList::NO_LIST_ERRORS && isDelete) {
+                    result = resolvedTarget;
+
+                    if (target >= 0) {
+                        isDeletedNode [target] = true;
+                    } else {
+                        isDeletedCreated [creatorIndex] = true;
+                    }
+                }
+
+                sequentialResults.push_back (errorCode == LinkedList::NO_LIST_ERRORS ? result : LinkedList::BATCH_SKIPPED);
+            }
+
+            LinkedList::ApplyBatchGrouped (&batchList, &batch);
+
+            bool isSame = IsSameOrder (&batchList, &sequentialList) && LinkedList::VerifyList (&batchList) == LinkedList::NO_LIST_ERRORS;
+
+            for (size_t operationIndex = 0; operationIndex < operationsCount; operationIndex++) {
+                isSame = isSame && (LinkedList::BatchResult (&batch, operationIndex) == LinkedList::BATCH_SKIPPED) ==
+                                   (sequentialResults [operationIndex] == LinkedList::BATCH_SKIPPED);
+            }
+
+            mismatches += isSame ? 0 : 1;
+
+            LinkedList::DestroyBatch (&batch);
+            LinkedList::DestroyList  (&batchList);
+            LinkedList::DestroyList  (&sequentialList);
+        }
+
+        return mismatches;
+    }
+
+    // Filling the batch is part of its cost. Returns the time taken
+    double RunBenchBatch (LinkedList::List <double> *list, LinkedList::ListBatch <double> *batch,
+                          const std::vector <BenchOperation> &operations, bool isGrouped) {
+        BenchClock::time_point start = BenchClock::now ();
+
+        LinkedList::ClearBatch (batch);
+
+        for (const BenchOperation &operation : operations) {
+            if (operation.type == LinkedList::BATCH_DELETE) {
+                LinkedList::BatchDelete (batch, operation.target, NULL);
+            } else {
+                LinkedList::BatchInsertAfter (batch, operation.target, 1.0, NULL);
+            }
+        }
+
+        if (isGrouped) {
+            LinkedList::ApplyBatchGrouped (list, batch);
+        } else {
+            LinkedList::ApplyBatch (list, batch);
+        }
+
+        return ElapsedNs (start);
+    }
+
+    // All lists get the same operations, so they also have to end up identical, up to the indices for grouped batches
+    bool BenchBatch () {
+        size_t mismatches        = CheckBatchAgainstSequentialCalls ();
+        size_t groupedMismatches = CheckGroupedBatchAgainstSequentialCalls ();
+
+        printf ("batch against sequential calls on full lists: %zu mismatches in %zu batches\n", mismatches, BATCH_CHECK_ROUNDS);
+        printf ("grouped batch against sequential calls:       %zu mismatches in %zu batches\n", groupedMismatches, BATCH_CHECK_ROUNDS);
+
+        std::mt19937_64 batchListRandom      (5);
+        std::mt19937_64 groupedListRandom    (5);
+        std::mt19937_64 sequentialListRandom (5);
+
+        LinkedList::List <double> batchList      = {};
+        LinkedList::List <double> groupedList    = {};
+        LinkedList::List <double> sequentialList = {};
+
+        std::vector <ssize_t> liveNodes = BuildShuffledList (&batchList,      BENCH_LIST_SIZE, BENCH_LIST_SIZE * 3 / 2, &batchListRandom);
+                                          BuildShuffledList (&groupedList,    BENCH_LIST_SIZE, BENCH_LIST_SIZE * 3 / 2, &groupedListRandom);
+                                          BuildShuffledList (&sequentialList, BENCH_LIST_SIZE, BENCH_LIST_SIZE * 3 / 2, &sequentialListRandom);
+
+        LinkedList::ListBatch <double> batch = {};
+        LinkedList::InitBatch (&batch, BATCH_SIZE);
+
+        std::mt19937_64 random (6);
+
+        double batchNs      = 0;
+        double groupedNs    = 0;
+        double sequentialNs = 0;
+
+        for (size_t round = 0; round < BATCH_ROUNDS; round++) {
+            std::vector <BenchOperation> operations = MakeBatchOperations (&liveNodes, &random);
+
+            BenchClock::time_point start = BenchClock::now ();
+
+            for (const BenchOperation &operation : operations) {
+                ssize_t newIndex = 0;
+
+                if (operation.type == LinkedList::BATCH_DELETE) {
+                    LinkedList::DeleteValue (&sequentialList, operation.target);
+                } else {
+                    LinkedList::InsertAfter (&sequentialList, operation.target, &newIndex, 1.0);
+                }
+            }
+
+            sequentialNs += ElapsedNs (start);
+
+            batchNs   += RunBenchBatch (&batchList,   &batch, operations, false);
+            groupedNs += RunBenchBatch (&groupedList, &batch, operations, true);
+        }
+
+        // Grouped batches give the new nodes other indices, so only the order can be compared
+        bool isSame        = IsSameList  (&batchList,   &sequentialList);
+        bool isGroupedSame = IsSameOrder (&groupedList, &sequentialList);
+
+        double operationsCount = (double) (BATCH_SIZE * BATCH_ROUNDS);
+
+        printf ("batches of %zu operations (70%% inserts) on a shuffled list of %zu nodes\n", BATCH_SIZE, BENCH_LIST_SIZE);
+        printf ("  sequential calls:  %6.2lf ns/operation\n", sequentialNs / operationsCount);
+        printf ("  ApplyBatch:        %6.2lf ns/operation (%.2lfx)%s\n", batchNs / operationsCount, sequentialNs / batchNs,
+                isSame ? "" : ", LISTS DIFFER");
+        printf ("  ApplyBatchGrouped: %6.2lf ns/operation (%.2lfx)%s\n", groupedNs / operationsCount, sequentialNs / groupedNs,
+                isGroupedSame ? "" : ", LISTS DIFFER");
+
+        LinkedList::DestroyBatch (&batch);
+        LinkedList::DestroyList  (&batchList);
+        LinkedList::DestroyList  (&groupedList);
+        LinkedList::DestroyList  (&sequentialList);
+
+        return mismatches == 0 && groupedMismatches == 0 && isSame && isGroupedSame;
+    }
+
+    bool IsSelected (int argc, char **argv, const char *benchName) {
+        return argc < 2 || strcmp (argv [1], benchName) == 0;
+    }
+}
+
+int main (int argc, char **argv) {
+    if (IsSelected (argc, argv, "traversal")) {
+        BenchTraversal ();
+    }
+
+    if (IsSelected (argc, argv, "lru")) {
+        BenchLruCache ();
+    }
+
+    bool isBatchCorrect = true;
+
+    if (IsSelected (argc, argv, "batch")) {
+        isBatchCorrect = BenchBatch ();
+    }
+
+    return isBatchCorrect ? 0 : 1;
+}
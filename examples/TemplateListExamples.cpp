@@ -0,0 +1,125 @@
+#include <cstdio>
+#include <string>
+
+#include <ColdList.hpp>
+#include <LinkedList.hpp>
+#include <LinkedListIterator.hpp>
+#include <LinkedListSort.hpp>
+#include <ListBatch.hpp>
+#include <ListOrderIndex.hpp>
+#include <LruCache.hpp>
+#include <UnrolledList.hpp>
+#include <VersionedList.hpp>
+
+// Walks through every header of the templated list once. It is built with the same flags as the main target,
+// so a Debug build also instantiates the Verification paths and their DumpList_
+static void ListExample () {
+    LinkedList::List <std::string> list = {};
+    LinkedList::InitList (&list, 8);
+
+    ssize_t worldIndex = 0;
+    ssize_t helloIndex = 0;
+    LinkedList::InsertAfter  (&list, 0, &worldIndex, std::string ("world"));
+    LinkedList::EmplaceAfter (&list, 0, &helloIndex, "hello");
+
+    LinkedList::EnableOrderIndex (&list);
+
+    ssize_t worldPosition = 0;
+    LinkedList::ListRankOf (&list, worldIndex, &worldPosition);
+
+    LinkedList::SortList (&list, [] (const std::string &first, const std::string &second) {return first > second;});
+
+    printf ("list:");
+
+    for (const std::string &word : list) {
+        printf (" %s", word.c_str ());
+    }
+
+    printf (" (world was at %zd)\n", worldPosition);
+
+    LinkedList::DumpList (&list, ".");
+    LinkedList::DestroyList (&list);
+}
+
+static void BatchExample () {
+    LinkedList::List <double> list = {};
+    LinkedList::InitList (&list, 16);
+
+    LinkedList::ListBatch <double> batch = {};
+    LinkedList::InitBatch (&batch, 0);
+
+    size_t firstInsert = 0;
+    LinkedList::BatchInsertAfter (&batch, 0, 1.0, &firstInsert);
+    LinkedList::BatchInsertAfter (&batch, LinkedList::BatchPlaceholder (firstInsert), 2.0, NULL);
+    LinkedList::ApplyBatch (&list, &batch);
+
+    double sum = 0;
+
+    for (double element : LinkedList::PrefetchingTraversal (&list)) {
+        sum += element;
+    }
+
+    printf ("batch: %zu applied, sum %lg\n", batch.appliedCount, sum);
+
+    LinkedList::DestroyBatch (&batch);
+    LinkedList::DestroyList  (&list);
+}
+
+static void LruCacheExample () {
+    LinkedList::LruCache <int, int> cache = {};
+    LinkedList::InitLruCache (&cache, 2);
+
+    LinkedList::LruCachePut (&cache, 1, 10);
+    LinkedList::LruCachePut (&cache, 2, 20);
+    LinkedList::LruCachePut (&cache, 3, 30);
+
+    int *value = NULL;
+    LinkedList::LruCacheGet (&cache, 1, &value);
+
+    printf ("lru: key 1 %s, %zu evictions\n", value ? "cached" : "evicted", cache.evictions);
+
+    LinkedList::DestroyLruCache (&cache);
+}
+
+static void OtherLayoutsExample () {
+    LinkedList::VersionedList <int> versionedList = {};
+    LinkedList::VersionedList <int> fork          = {};
+    LinkedList::InitList (&versionedList, 8);
+
+    ssize_t newIndex = 0;
+    LinkedList::InsertAfter (&versionedList, 0, &newIndex, 1);
+    LinkedList::ForkList    (&versionedList, &fork);
+    LinkedList::DeleteValue (&fork, newIndex);
+
+    LinkedList::UnrolledList <int> unrolledList = {};
+    LinkedList::InitList (&unrolledList, 8);
+
+    ssize_t handle = 0;
+    LinkedList::InsertAfter (&unrolledList, 0, &handle, 5);
+
+    LinkedList::ColdList coldList = {};
+    LinkedList::InitList (&coldList, 8);
+
+    ssize_t coldIndex = 0;
+    LinkedList::InsertAfter (&coldList, 0, &coldIndex, 2.5);
+    LinkedList::FreezeList  (&coldList);
+
+    double coldValue = 0;
+    LinkedList::ColdListValue (&coldList, coldIndex, &coldValue);
+
+    printf ("layouts: unrolled %d, cold %lg\n", LinkedList::UnrolledListValue (&unrolledList, handle), coldValue);
+
+    LinkedList::DestroyList (&coldList);
+    LinkedList::DestroyList (&unrolledList);
+    LinkedList::DestroyList (&fork);
+    LinkedList::DestroyList (&versionedList);
+}
+
+int main () {
+    ListExample         ();
+    BatchExample        ();
+    LruCacheExample     ();
+    OtherLayoutsExample ();
+
+    return 0;
+}
@@ -0,0 +1,470 @@
+#ifndef COLD_LIST_HPP_
+#define COLD_LIST_HPP_
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <sys/types.h>
+
+#include <LinkedList.hpp>
+
+namespace LinkedList {
+    const size_t COLD_BLOCK_SIZE          = 512; // Values per independently decodable block
+    const size_t COLD_MAX_BITS_PER_VALUE  = 2 + 5 + 6 + 64;
+    const int    COLD_MAX_LEADING_ZEROS   = 31;  // Leading zeros are stored in 5 bits
+
+    // List <double> that can be frozen into a Gorilla (XOR) compressed stream in logical order.
+    // Reads work on both forms, the first write thaws the list back: node k of the frozen list becomes index k.
+    // On 1M-value random walks and noisy sines the stream is only 1.25-1.35x smaller than the raw doubles: most of the
+    // 3.7-4x saving over the thawed list comes from dropping next and prev. Only slowly changing data does much better
+    struct ColdList {
+        List <double> list          = {};    // Mutable form, its arrays are released while the list is frozen
+
+        uint64_t     *words         = NULL;  // Every block starts on a word boundary
+        size_t       *blockStarts   = NULL;  // Index of the first word of every block
+        size_t        blocksCount   = 0;
+        size_t        size          = 0;
+
+        ssize_t       capacity      = -1;    // Capacity of the thawed list
+        bool          hadOrderIndex = false; // ThawList rebuilds the order index the list had when it was frozen
+        bool          isFrozen      = false;
+    };
+
+    struct ColdBitWriter {
+        uint64_t *words    = NULL;
+        size_t    position = 0;
+
+        // Bits go MSB first; value must not have bits above bitsCount set
+        void Write (uint64_t value, unsigned bitsCount) {
+            size_t   wordIndex = position / 64;
+            unsigned freeBits  = 64 - (unsigned) (position % 64);
+
+            if (bitsCount <= freeBits) {
+                words [wordIndex] |= value << (freeBits - bitsCount);
+            } else {
+                words [wordIndex]     |= value >> (bitsCount - freeBits);
+                words [wordIndex + 1] |= value << (64 - (bitsCount - freeBits));
+            }
+
+            position += bitsCount;
+        }
+    };
+
+    struct ColdBitReader {
+        const uint64_t *words    = NULL;
+        size_t          position = 0;
+
+        uint64_t Read (unsigned bitsCount) {
+            size_t   wordIndex = position / 64;
+            unsigned usedBits  = (unsigned) (position % 64);
+            unsigned freeBits  = 64 - usedBits;
+            uint64_t value     = 0;
+
+            if (bitsCount <= freeBits) {
+                value = (words [wordIndex] << usedBits) >> (64 - bitsCount);
+            } else {
+                value = ((words [wordIndex] & ((1ULL << freeBits) - 1)) << (bitsCount - freeBits)) |
+                        (words [wordIndex + 1] >> (64 - (bitsCount - freeBits)));
+            }
+
+            position += bitsCount;
+
+            return value;
+        }
+    };
+
+    // Gorilla state shared by the encoder and the decoder of one block
+    struct ColdCodecState {
+        uint64_t previous = 0;
+        int      leading  = -1; // -1 until the first meaningful window is written
+        int      trailing = 0;
+    };
+
+    inline uint64_t ColdBits_ (double value) {
+        uint64_t bits = 0;
+        memcpy (&bits, &value, sizeof (bits));
+        return bits;
+    }
+
+    inline double ColdValue_ (uint64_t bits) {
+        double value = 0;
+        memcpy (&value, &bits, sizeof (value));
+        return value;
+    }
+
+    inline void EncodeColdValue_ (ColdBitWriter *writer, ColdCodecState *state, uint64_t bits) {
+        uint64_t xorBits = bits ^ state->previous;
+
+        state->previous = bits;
+
+        if (xorBits == 0) {
+            writer->Write (0, 1);
+            return;
+        }
+
+        int leading  = std::min (__builtin_clzll (xorBits), COLD_MAX_LEADING_ZEROS);
+        int trailing = __builtin_ctzll (xorBits);
+
+        // Reuse the previous window when the meaningful bits fit into it
+        if (state->leading >= 0 && leading >= state->leading && trailing >= state->trailing) {
+            writer->Write (0x2, 2);
+            writer->Write (xorBits >> state->trailing, (unsigned) (64 - state->leading - state->trailing));
+            return;
+        }
+
+        int meaningful = 64 - leading - trailing;
+
+        writer->Write (0x3, 2);
+        writer->Write ((uint64_t) leading,        5);
+        writer->Write ((uint64_t) meaningful - 1, 6);
+        writer->Write (xorBits >> trailing, (unsigned) meaningful);
+
+        state->leading  = leading;
+        state->trailing = trailing;
+    }
+
+    inline uint64_t DecodeColdValue_ (ColdBitReader *reader, ColdCodecState *state) {
+        if (reader->Read (1) == 0) {
+            return state->previous;
+        }
+
+        if (reader->Read (1) == 1) {
+            state->leading  = (int) reader->Read (5);
+            int meaningful  = (int) reader->Read (6) + 1;
+            state->trailing = 64 - state->leading - meaningful;
+        }
+
+        state->previous ^= reader->Read ((unsigned) (64 - state->leading - state->trailing)) << state->trailing;
+
+        return state->previous;
+    }
+
+    // Positions the reader on the first value of a block and decodes it
+    inline double StartColdBlock_ (const ColdList *coldList, size_t blockIndex, ColdBitReader *reader, ColdCodecState *state) {
+        reader->words    = coldList->words;
+        reader->position = coldList->blockStarts [blockIndex] * 64;
+
+        *state          = {};
+        state->previous = reader->Read (64);
+
+        return ColdValue_ (state->previous);
+    }
+
+    inline ListErrorCode InitList_ (ColdList *coldList, size_t capacity, CallingFileData creationData) {
+        if (!coldList) {
+            return LIST_NULL_POINTER;
+        }
+
+        *coldList = {};
+        coldList->capacity = (ssize_t) capacity + 1;
+
+        return InitList_ (&coldList->list, capacity, creationData);
+    }
+
+    inline ListErrorCode DestroyList_ (ColdList *coldList) {
+        if (!coldList) {
+            return LIST_NULL_POINTER;
+        }
+
+        free (coldList->words);
+        free (coldList->blockStarts);
+
+        ListErrorCode errorCode = coldList->isFrozen ? NO_LIST_ERRORS : DestroyList_ (&coldList->list);
+
+        *coldList = {};
+
+        return errorCode;
+    }
+
+    inline ListErrorCode FreezeList_ (ColdList *coldList, CallingFileData callData) {
+        if (!coldList) {
+            return LIST_NULL_POINTER;
+        }
+
+        if (coldList->isFrozen) {
+            return NO_LIST_ERRORS;
+        }
+
+        List <double> *list = &coldList->list;
+
+        Verification (list, callData);
+
+        size_t size = 0;
+
+        for (ssize_t nodeIndex = list->next [0]; nodeIndex != 0; nodeIndex = list->next [nodeIndex]) {
+            size++;
+        }
+
+        size_t blocksCount   = (size + COLD_BLOCK_SIZE - 1) / COLD_BLOCK_SIZE;
+        size_t wordsPerBlock = (64 + (COLD_BLOCK_SIZE - 1) * COLD_MAX_BITS_PER_VALUE + 63) / 64;
+
+        uint64_t *words       = (uint64_t *) calloc (blocksCount * wordsPerBlock + 1, sizeof (uint64_t));
+        size_t   *blockStarts = (size_t *)   calloc (blocksCount + 1,                 sizeof (size_t));
+
+        if (!words || !blockStarts) {
+            free (words);
+            free (blockStarts);
+
+            return DATA_NULL_POINTER;
+        }
+
+        ColdBitWriter  writer = {words, 0};
+        ColdCodecState state  = {};
+        size_t         position = 0;
+
+        for (ssize_t nodeIndex = list->next [0]; nodeIndex != 0; nodeIndex = list->next [nodeIndex], position++) {
+            uint64_t bits = ColdBits_ (list->data [nodeIndex]);
+
+            if (position % COLD_BLOCK_SIZE == 0) {
+                writer.position = (writer.position + 63) / 64 * 64;
+                blockStarts [position / COLD_BLOCK_SIZE] = writer.position / 64;
+
+                state          = {};
+                state.previous = bits;
+
+                writer.Write (bits, 64);
+            } else {
+                EncodeColdValue_ (&writer, &state, bits);
+            }
+        }
+
+        size_t    usedWords    = (writer.position + 63) / 64 + 1; // Reader may touch the word after the last bit
+        uint64_t *shrunkWords  = (uint64_t *) realloc (words, usedWords * sizeof (uint64_t));
+
+        coldList->words         = shrunkWords ? shrunkWords : words;
+        coldList->blockStarts   = blockStarts;
+        coldList->blocksCount   = blocksCount;
+        coldList->size          = size;
+        coldList->capacity      = list->capacity;
+        coldList->hadOrderIndex = list->orderIndex != NULL;
+
+        CallingFileData creationData = list->creationData;
+
+        DestroyList_ (list);
+
+        *list = {};
+        list->creationData = creationData;
+
+        coldList->isFrozen = true;
+
+        return NO_LIST_ERRORS;
+    }
+
+    inline ListErrorCode ThawList_ (ColdList *coldList, CallingFileData callData) {
+        if (!coldList) {
+            return LIST_NULL_POINTER;
+        }
+
+        if (!coldList->isFrozen) {
+            return NO_LIST_ERRORS;
+        }
+
+        List <double> *list = &coldList->list;
+
+        ListErrorCode errorCode = InitList_ (list, (size_t) coldList->capacity - 1, list->creationData);
+
+        if (errorCode != NO_LIST_ERRORS) {
+            return errorCode;
+        }
+
+        ColdBitReader  reader = {};
+        ColdCodecState state  = {};
+        ssize_t        size   = (ssize_t) coldList->size;
+
+        for (ssize_t nodeIndex = 1; nodeIndex <= size; nodeIndex++) {
+            if ((size_t) (nodeIndex - 1) % COLD_BLOCK_SIZE == 0) {
+                list->data [nodeIndex] = StartColdBlock_ (coldList, (size_t) (nodeIndex - 1) / COLD_BLOCK_SIZE, &reader, &state);
+            } else {
+                list->data [nodeIndex] = ColdValue_ (DecodeColdValue_ (&reader, &state));
+            }
+
+            list->next [nodeIndex] = nodeIndex + 1;
+            list->prev [nodeIndex] = nodeIndex - 1;
+        }
+
+        if (size > 0) {
+            list->next [size] = 0;
+        }
+
+        list->next [0] = size > 0 ? 1 : 0;
+        list->prev [0] = size;
+
+        list->freeElem = size + 1 < list->capacity ? size + 1 : 0;
+
+        free (coldList->words);
+        free (coldList->blockStarts);
+
+        coldList->words       = NULL;
+        coldList->blockStarts = NULL;
+        coldList->blocksCount = 0;
+        coldList->size        = 0;
+        coldList->isFrozen    = false;
+
+        Verification (list, callData);
+
+        if (coldList->hadOrderIndex) {
+            coldList->hadOrderIndex = false;
+
+            return EnableOrderIndex_ (list, callData);
+        }
+
+        return NO_LIST_ERRORS;
+    }
+
+    // Random access decodes only the block holding the value
+    inline ListErrorCode ColdListValue_ (ColdList *coldList, ssize_t index, double *value, CallingFileData callData) {
+        assert (value);
+
+        if (!coldList->isFrozen) {
+            if (index <= 0 || index >= coldList->list.capacity || coldList->list.prev [index] == -1) {
+                return WRONG_INDEX;
+            }
+
+            *value = coldList->list.data [index];
+
+            return NO_LIST_ERRORS;
+        }
+
+        if (index <= 0 || (size_t) index > coldList->size) {
+            return WRONG_INDEX;
+        }
+
+        size_t position   = (size_t) index - 1;
+        size_t blockIndex = position / COLD_BLOCK_SIZE;
+
+        ColdBitReader  reader  = {};
+        ColdCodecState state   = {};
+        double         decoded = StartColdBlock_ (coldList, blockIndex, &reader, &state);
+
+        for (size_t skipped = blockIndex * COLD_BLOCK_SIZE; skipped < position; skipped++) {
+            decoded = ColdValue_ (DecodeColdValue_ (&reader, &state));
+        }
+
+        *value = decoded;
+
+        return NO_LIST_ERRORS;
+    }
+
+    inline ListErrorCode InsertAfter_ (ColdList *coldList, ssize_t insertIndex, ssize_t *newIndex, double element, CallingFileData callData) {
+        ListErrorCode errorCode = ThawList_ (coldList, callData);
+
+        if (errorCode != NO_LIST_ERRORS) {
+            return errorCode;
+        }
+
+        return InsertAfter_ (&coldList->list, insertIndex, newIndex, element, callData);
+    }
+
+    inline ListErrorCode DeleteValue_ (ColdList *coldList, ssize_t deleteIndex, CallingFileData callData) {
+        ListErrorCode errorCode = ThawList_ (coldList, callData);
+
+        if (errorCode != NO_LIST_ERRORS) {
+            return errorCode;
+        }
+
+        return DeleteValue_ (&coldList->list, deleteIndex, callData);
+    }
+
+    inline ListErrorCode MoveAfter_ (ColdList *coldList, ssize_t insertIndex, ssize_t moveIndex, CallingFileData callData) {
+        ListErrorCode errorCode = ThawList_ (coldList, callData);
+
+        if (errorCode != NO_LIST_ERRORS) {
+            return errorCode;
+        }
+
+        return MoveAfter_ (&coldList->list, insertIndex, moveIndex, callData);
+    }
+
+    // Streaming decode for a frozen list, plain next traversal otherwise; index 0 is the end
+    struct ColdListIterator {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = double;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const double *;
+        using reference         = double;
+
+        const ColdList *coldList = NULL;
+        ssize_t         index    = 0;
+        double          value    = 0;
+
+        ColdBitReader   reader   = {};
+        ColdCodecState  state    = {};
+
+        ColdListIterator () = default;
+
+        explicit ColdListIterator (const ColdList *traversedList) : coldList (traversedList) {
+            if (coldList->isFrozen) {
+                if (coldList->size > 0) {
+                    index = 1;
+                    value = StartColdBlock_ (coldList, 0, &reader, &state);
+                }
+            } else {
+                index = coldList->list.next [0];
+                value = coldList->list.data [index];
+            }
+        }
+
+        ssize_t   Index      () const {return index;}
+        reference operator*  () const {return value;}
+        pointer   operator-> () const {return &value;}
+
+        ColdListIterator &operator++ () {
+            if (!coldList->isFrozen) {
+                index = coldList->list.next [index];
+                value = coldList->list.data [index];
+
+                return *this;
+            }
+
+            if ((size_t) index == coldList->size) {
+                index = 0;
+            } else if ((size_t) index % COLD_BLOCK_SIZE == 0) {
+                value = StartColdBlock_ (coldList, (size_t) index / COLD_BLOCK_SIZE, &reader, &state);
+                index++;
+            } else {
+                value = ColdValue_ (DecodeColdValue_ (&reader, &state));
+                index++;
+            }
+
+            return *this;
+        }
+
+        ColdListIterator operator++ (int) {
+            ColdListIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator== (const ColdListIterator &other) const {return index == other.index;}
+        bool operator!= (const ColdListIterator &other) const {return !(*this == other);}
+    };
+
+    inline ColdListIterator begin (const ColdList &coldList) {return ColdListIterator (&coldList);}
+    inline ColdListIterator end   (const ColdList &coldList) {return {};}
+
+    inline ListErrorCode FindValueInListSlowImplementation_ (ColdList *coldList, double value, ssize_t *index, CallingFileData callData) {
+        if (!coldList->isFrozen) {
+            return FindValueInListSlowImplementation_ (&coldList->list, value, index, callData);
+        }
+
+        for (ColdListIterator iterator (coldList); iterator != end (*coldList); ++iterator) {
+            if (std::abs (*iterator - value) < EPS) {
+                *index = iterator.Index ();
+                return NO_LIST_ERRORS;
+            }
+        }
+
+        *index = -1;
+        return NO_LIST_ERRORS;
+    }
+
+    #define FreezeList(list)                  FreezeList_    (list, CreateCallingFileData)
+    #define ThawList(list)                    ThawList_      (list, CreateCallingFileData)
+    #define ColdListValue(list, index, value) ColdListValue_ (list, index, value, CreateCallingFileData)
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define GRAPHVIZ_DUMP_H_
 
 #include "LinkedList.h"
+#include <stdint.h>
 #include <stdio.h>
 
 namespace LinkedList {
@@ -10,6 +11,25 @@ namespace LinkedList {
     const size_t MAX_INDEX_LENGTH     = 32;
     const size_t MAX_NODE_DATA_LENGTH = 256;
 
+    const size_t MAX_PENDING_DUMPS    = 64; // Queued snapshots; a dump that neither fits nor merges into a pending one is dropped
+    const size_t MAX_DUMP_BATCH_SIZE  = 16; // Dot files rendered by a single dot process
+    const size_t DUMP_WORKERS_COUNT   = 2;  // Upper bound of dot processes running at the same time
+
+    const ssize_t MAX_FULL_DUMP_NODES         = 4096; // DumpList falls back to the summary mode for bigger lists
+    const size_t  MAX_SUMMARY_RUNS            = 128;  // Runs per chain in a summary, scattered ones are merged beyond that
+    const size_t  DUMP_NODE_LENGTH_ESTIMATE   = 384;  // Node record with both of its connections
+    const size_t  DUMP_HEADER_LENGTH_ESTIMATE = 2 * FILENAME_MAX + 1024;
+
+    const char BINARY_DUMP_SIGNATURE [8] = "LLSNAP1";
+
+    // Raw snapshot layout: header followed by data, next and prev arrays of capacity elements each
+    struct BinaryDumpHeader {
+        char     signature [8] = {};
+        uint64_t elementSize   = sizeof (elem_t);
+        int64_t  capacity      = 0;
+        int64_t  freeElem      = 0;
+    };
+
     #define DUMP_NODE_COLOR                 "#5e69db"
     #define DUMP_NODE_OUTLINE_COLOR         "#000000"
     #define DUMP_FREE_NODE_OUTLINE_COLOR    "#10c929"
@@ -25,6 +25,19 @@ namespace LinkedList {
         INVALID_TAIL            = 1 << 10,
     };
 
+    enum DumpMode {
+        FULL_DUMP    = 0, // Every slot of the list
+        WINDOW_DUMP  = 1, // windowRadius hops around windowCenter in both directions
+        SUMMARY_DUMP = 2, // Live and free chains with their neighbouring slots collapsed into runs
+        BINARY_DUMP  = 3, // Raw arrays for offline rendering
+    };
+
+    struct DumpParameters {
+        DumpMode mode         = FULL_DUMP;
+        ssize_t  windowCenter = 0;
+        size_t   windowRadius = 16;
+    };
+
     struct CallingFileData {
         int line             = -1;
         const char *file     = NULL;
@@ -43,6 +56,8 @@ namespace LinkedList {
 
         ListErrorCode errors;
         CallingFileData creationData;
+
+        size_t generation   = 0; // New for every InitList, tells apart lists that reuse the same memory
     };
 
     ListErrorCode InitList_    (List *list, size_t capacity, CallingFileData creationData);
@@ -52,9 +67,12 @@ namespace LinkedList {
     ListErrorCode VerifyList_  (List *list);
     ListErrorCode DumpList_    (List *list, char *logFolder, CallingFileData callData);
 
+    ListErrorCode DumpListWithParameters_ (List *list, char *logFolder, DumpParameters parameters, CallingFileData callData);
+
     ListErrorCode FindValueInListSlowImplementation_ (List *list, elem_t value, ssize_t *index, CallingFileData callData);
 
     ListErrorCode ClearHtmlFile ();
+    ListErrorCode FlushDumps    ();
 
     #define CreateCallingFileData {__LINE__, __FILE__, __PRETTY_FUNCTION__}
 
@@ -68,5 +86,8 @@ namespace LinkedList {
     #define FindValueInListSlowImplementation(list, value, index)\
                 FindValueInListSlowImplementation_ (list, value, index, CreateCallingFileData);
 
+    #define DumpListWithParameters(list, logFolder, parameters)\
+                DumpListWithParameters_ (list, logFolder, parameters, CreateCallingFileData)
+
 }
 #endif
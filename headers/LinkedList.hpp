@@ -2,12 +2,19 @@
 #define LINKED_LIST_HPP_
 
 #include <cassert>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 #include <stdlib.h>
 #include <sys/types.h>
+#include <type_traits>
+#include <utility>
 
 #include <LinkedListDefinitions.hpp>
+#include <LinkedListIterator.hpp>
+#include <ListOrderIndex.hpp>
 
 #ifndef NDEBUG
     #define ON_DEBUG(...) __VA_ARGS__
@@ -27,6 +34,22 @@
     )
 
 namespace LinkedList {
+    // Slots of data are raw storage: an element lives in a slot only while the slot is linked into the list
+    template <typename elem_t>
+    elem_t *AllocateElements_ (size_t count) {
+        if constexpr (alignof (elem_t) <= alignof (max_align_t)) {
+            return (elem_t *) calloc (count, sizeof (elem_t));
+        } else {
+            elem_t *elements = (elem_t *) aligned_alloc (alignof (elem_t), (count * sizeof (elem_t) + alignof (elem_t) - 1) / alignof (elem_t) * alignof (elem_t));
+
+            if (elements) {
+                memset ((void *) elements, 0, count * sizeof (elem_t));
+            }
+
+            return elements;
+        }
+    }
+
     template <typename elem_t>
     ListErrorCode InitList_ (List <elem_t> *list, size_t capacity, CallingFileData creationData) {
         if (!list) {
@@ -37,7 +60,7 @@ namespace LinkedList {
 
         list->next = (ssize_t *) calloc ((size_t) list->capacity, sizeof (ssize_t));
         list->prev = (ssize_t *) calloc ((size_t) list->capacity, sizeof (ssize_t));
-        list->data = (elem_t *)  calloc ((size_t) list->capacity, sizeof (elem_t));
+        list->data = AllocateElements_ <elem_t> ((size_t) list->capacity);
 
         #define CheckForNull(expression, error) if (!(expression)) {return error;}
 
@@ -70,7 +93,16 @@ namespace LinkedList {
             return LIST_NULL_POINTER;
         }
 
-        #define ZeroMemory(arrayPointer) memset (arrayPointer, 0, (size_t) list->capacity * sizeof (elem_t))
+        if constexpr (!std::is_trivially_destructible_v <elem_t>) {
+            if (list->data && list->next) {
+                for (ssize_t elementIndex = list->next [0]; elementIndex > 0; elementIndex = list->next [elementIndex]) {
+                    list->data [elementIndex].~elem_t ();
+                }
+            }
+        }
+
+        #define ZeroMemory(arrayPointer) \
+            if (arrayPointer) memset ((void *) (arrayPointer), 0, (size_t) list->capacity * sizeof (*(arrayPointer)))
 
         ZeroMemory (list->data);
         ZeroMemory (list->prev);
@@ -82,11 +114,13 @@ namespace LinkedList {
 
         #undef ZeroMemory
 
-        return NO_LIST_ERRORS;
+        return DisableOrderIndex_ (list);
     }
 
+    // Validates insertIndex and hands out a free slot without linking it: the element is constructed first,
+    // so a throwing constructor leaves the list untouched
     template <typename elem_t>
-    ListErrorCode InsertAfter_ (List <elem_t> *list, ssize_t insertIndex, ssize_t *newIndex, elem_t element, CallingFileData callData) {
+    ListErrorCode AcquireFreeSlot_ (List <elem_t> *list, ssize_t insertIndex, ssize_t *newIndex, CallingFileData callData) {
         assert (newIndex);
 
         Verification (list, callData);
@@ -104,18 +138,68 @@ namespace LinkedList {
         }
 
         *newIndex = list->freeElem;
-        list->freeElem = list->next [list->freeElem];
 
-        list->prev [list->next [insertIndex]] = *newIndex;
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t>
+    void LinkAcquiredSlot_ (List <elem_t> *list, ssize_t insertIndex, ssize_t newIndex) {
+        list->freeElem = list->next [newIndex];
+
+        list->prev [list->next [insertIndex]] = newIndex;
+
+        list->next [newIndex]    = list->next [insertIndex];
+        list->next [insertIndex] = newIndex;
+        list->prev [newIndex]    = insertIndex;
 
-        list->next [*newIndex]   = list->next [insertIndex];
-        list->next [insertIndex] = *newIndex;
-        list->prev [*newIndex]   = insertIndex;
-        list->data [*newIndex]   = element;
+        if (list->orderIndex) {
+            OrderIndexInsertAfter_ (list->orderIndex, insertIndex, newIndex);
+        }
+    }
+
+    template <typename elem_t, typename... Args>
+    ListErrorCode EmplaceAfter_ (List <elem_t> *list, ssize_t insertIndex, ssize_t *newIndex, CallingFileData callData, Args &&... args) {
+        ListErrorCode errorCode = AcquireFreeSlot_ (list, insertIndex, newIndex, callData);
+
+        if (errorCode != NO_LIST_ERRORS) {
+            return errorCode;
+        }
+
+        new (list->data + *newIndex) elem_t (std::forward <Args> (args)...);
+
+        LinkAcquiredSlot_ (list, insertIndex, *newIndex);
 
         return NO_LIST_ERRORS;
     }
 
+    template <typename elem_t>
+    ListErrorCode InsertAfter_ (List <elem_t> *list, ssize_t insertIndex, ssize_t *newIndex, const NonDeduced <elem_t> &element, CallingFileData callData) {
+        if constexpr (std::is_trivially_copyable_v <elem_t>) {
+            ListErrorCode errorCode = AcquireFreeSlot_ (list, insertIndex, newIndex, callData);
+
+            if (errorCode != NO_LIST_ERRORS) {
+                return errorCode;
+            }
+
+            memcpy ((void *) (list->data + *newIndex), &element, sizeof (elem_t));
+
+            LinkAcquiredSlot_ (list, insertIndex, *newIndex);
+
+            return NO_LIST_ERRORS;
+        } else {
+            return EmplaceAfter_ (list, insertIndex, newIndex, callData, element);
+        }
+    }
+
+    template <typename elem_t>
+    ListErrorCode InsertAfter_ (List <elem_t> *list, ssize_t insertIndex, ssize_t *newIndex, NonDeduced <elem_t> &&element, CallingFileData callData) {
+        if constexpr (std::is_trivially_copyable_v <elem_t>) {
+            return InsertAfter_ (list, insertIndex, newIndex, (const elem_t &) element, callData);
+        } else {
+            return EmplaceAfter_ (list, insertIndex, newIndex, callData, std::move (element));
+        }
+    }
+
     template <typename elem_t>
     ListErrorCode DeleteValue_ (List <elem_t> *list, ssize_t deleteIndex, CallingFileData callData) {
 
@@ -132,6 +216,14 @@ namespace LinkedList {
         list->prev [list->next [deleteIndex]] = list->prev [deleteIndex];
         list->next [list->prev [deleteIndex]] = list->next [deleteIndex];
 
+        if constexpr (!std::is_trivially_destructible_v <elem_t>) {
+            list->data [deleteIndex].~elem_t ();
+        }
+
+        if (list->orderIndex) {
+            OrderIndexErase_ (list->orderIndex, deleteIndex);
+        }
+
         list->next [deleteIndex]    = list->freeElem;
         list->prev [deleteIndex]    = -1;
         list->freeElem              = deleteIndex;
@@ -139,6 +231,41 @@ namespace LinkedList {
         return NO_LIST_ERRORS;
     }
 
+    // Relinks moveIndex right after insertIndex; the payload stays in its slot and the index stays valid
+    template <typename elem_t>
+    ListErrorCode MoveAfter_ (List <elem_t> *list, ssize_t insertIndex, ssize_t moveIndex, CallingFileData callData) {
+
+        Verification (list, callData);
+
+        if (moveIndex <= 0 || moveIndex >= list->capacity || insertIndex < 0 || insertIndex >= list->capacity) {
+            return WRONG_INDEX;
+        }
+
+        if (list->prev [moveIndex] == -1 || list->prev [insertIndex] == -1) {
+            return WRONG_INDEX;
+        }
+
+        if (insertIndex == moveIndex || list->next [insertIndex] == moveIndex) {
+            return NO_LIST_ERRORS;
+        }
+
+        list->prev [list->next [moveIndex]] = list->prev [moveIndex];
+        list->next [list->prev [moveIndex]] = list->next [moveIndex];
+
+        list->prev [list->next [insertIndex]] = moveIndex;
+
+        list->next [moveIndex]   = list->next [insertIndex];
+        list->next [insertIndex] = moveIndex;
+        list->prev [moveIndex]   = insertIndex;
+
+        if (list->orderIndex) {
+            OrderIndexErase_       (list->orderIndex, moveIndex);
+            OrderIndexInsertAfter_ (list->orderIndex, insertIndex, moveIndex);
+        }
+
+        return NO_LIST_ERRORS;
+    }
+
     template <typename elem_t>
     ListErrorCode VerifyList (List <elem_t> *list) {
 
@@ -178,11 +305,78 @@ namespace LinkedList {
         return list->errors;
     }
 
+    const ssize_t MAX_TEXT_DUMP_NODES = 1024;
+
+    // GraphViz dumps belong to the non-template List, List <elem_t> gets a plain text one: the header and the first
+    // MAX_TEXT_DUMP_NODES slots are appended to logFolder/list_dump.txt. Values are printed for arithmetic types only
     template <typename elem_t>
-    ListErrorCode FindValueInListSlowImplementation_ (List <elem_t> *list, elem_t value, ssize_t *index, CallingFileData callData) {
+    ListErrorCode DumpList_ (List <elem_t> *list, char *logFolder, CallingFileData callData) {
+        if (!list) {
+            return LIST_NULL_POINTER;
+        }
+
+        char dumpFilename [FILENAME_MAX] = "";
+        snprintf (dumpFilename, FILENAME_MAX, "%s/list_dump.txt", logFolder);
+
+        FILE *dumpFile = fopen (dumpFilename, "a");
+
+        if (!dumpFile) {
+            return LOG_FILE_ERROR;
+        }
+
+        CallingFileData *creationData = &list->creationData;
+
+        fprintf (dumpFile, "List dump called from %s:%d (%s)\n", callData.file ? callData.file : "(null)", callData.line,
+                 callData.function ? callData.function : "(null)");
+        fprintf (dumpFile, "Created in %s:%d (%s)\n", creationData->file ? creationData->file : "(null)", creationData->line,
+                 creationData->function ? creationData->function : "(null)");
+        fprintf (dumpFile, "capacity = %zd, free = %zd, errors = %d\n", list->capacity, list->freeElem, (int) list->errors);
+
+        if (list->next && list->prev) {
+            ssize_t dumpedNodes = list->capacity < MAX_TEXT_DUMP_NODES ? list->capacity : MAX_TEXT_DUMP_NODES;
+
+            for (ssize_t nodeIndex = 0; nodeIndex < dumpedNodes; nodeIndex++) {
+                fprintf (dumpFile, "%8zd: next = %8zd, prev = %8zd", nodeIndex, list->next [nodeIndex], list->prev [nodeIndex]);
+
+                if constexpr (std::is_arithmetic_v <elem_t>) {
+                    if (list->data && nodeIndex != 0 && list->prev [nodeIndex] != -1) {
+                        if constexpr (std::is_floating_point_v <elem_t>) {
+                            fprintf (dumpFile, ", data = %Lg", (long double) list->data [nodeIndex]);
+                        } else if constexpr (std::is_signed_v <elem_t>) {
+                            fprintf (dumpFile, ", data = %lld", (long long) list->data [nodeIndex]);
+                        } else {
+                            fprintf (dumpFile, ", data = %llu", (unsigned long long) list->data [nodeIndex]);
+                        }
+                    }
+                }
+
+                fputc ('\n', dumpFile);
+            }
+
+            if (dumpedNodes < list->capacity) {
+                fprintf (dumpFile, "... %zd more slots\n", list->capacity - dumpedNodes);
+            }
+        }
+
+        fputc ('\n', dumpFile);
+        fclose (dumpFile);
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t>
+    ListErrorCode FindValueInListSlowImplementation_ (List <elem_t> *list, const NonDeduced <elem_t> &value, ssize_t *index, CallingFileData callData) {
 
         for (ssize_t elementIndex = list->next [0]; elementIndex != 0; elementIndex = list->next [elementIndex]) {
-            if (abs (list->data [elementIndex] - value) < EPS) {
+            bool isEqual = false;
+
+            if constexpr (std::is_floating_point_v <elem_t>) {
+                isEqual = std::abs (list->data [elementIndex] - value) < EPS;
+            } else {
+                isEqual = list->data [elementIndex] == value;
+            }
+
+            if (isEqual) {
                 *index = elementIndex;
                 return NO_LIST_ERRORS;
             }
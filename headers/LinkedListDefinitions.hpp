@@ -6,6 +6,16 @@
 
 namespace LinkedList {
     const size_t REALLOC_SCALE = 2;
+    const double EPS           = 1e-5;
+
+    // Keeps element arguments out of template deduction, so InsertAfter (&list, 0, &index, 5) works for List <double>
+    template <typename type_t>
+    struct NonDeducedType {
+        using type = type_t;
+    };
+
+    template <typename type_t>
+    using NonDeduced = typename NonDeducedType <type_t>::type;
 
     enum ListErrorCode {
         NO_LIST_ERRORS          = 0,
@@ -20,6 +30,9 @@ namespace LinkedList {
         INVALID_CAPACITY        = 1 << 8,
         INVALID_HEAD            = 1 << 9,
         INVALID_TAIL            = 1 << 10,
+        INVALID_LINKS           = 1 << 11, // next and prev of two live nodes disagree
+        INVALID_REFERENCES      = 1 << 12, // Shared storage with a zero reference count
+        BATCH_ALREADY_APPLIED   = 1 << 13, // A batch has to be cleared before it is filled or applied again
     };
 
     struct CallingFileData {
@@ -28,6 +41,8 @@ namespace LinkedList {
         const char *function = NULL;
     };
 
+    struct ListOrderIndex;
+
     template <typename elem_t>
     struct List {
         elem_t *data        = NULL;
@@ -39,6 +54,8 @@ namespace LinkedList {
 
         ssize_t freeElem    = -1;
 
+        ListOrderIndex *orderIndex = NULL; // Optional positional index, see EnableOrderIndex
+
         ListErrorCode errors;
         CallingFileData creationData;
     };
@@ -48,15 +65,27 @@ namespace LinkedList {
     template <typename elem_t>
     ListErrorCode DestroyList_ (List <elem_t> *list);
     template <typename elem_t>
-    ListErrorCode InsertAfter_ (List <elem_t> *list, ssize_t insertIndex, ssize_t *newIndex, elem_t element, CallingFileData callData);
+    ListErrorCode InsertAfter_ (List <elem_t> *list, ssize_t insertIndex, ssize_t *newIndex, const NonDeduced <elem_t> &element, CallingFileData callData);
+    template <typename elem_t>
+    ListErrorCode InsertAfter_ (List <elem_t> *list, ssize_t insertIndex, ssize_t *newIndex, NonDeduced <elem_t> &&element, CallingFileData callData);
+    template <typename elem_t, typename... Args>
+    ListErrorCode EmplaceAfter_ (List <elem_t> *list, ssize_t insertIndex, ssize_t *newIndex, CallingFileData callData, Args &&... args);
     template <typename elem_t>
     ListErrorCode DeleteValue_ (List <elem_t> *list, ssize_t deleteIndex, CallingFileData callData);
     template <typename elem_t>
+    ListErrorCode MoveAfter_   (List <elem_t> *list, ssize_t insertIndex, ssize_t moveIndex, CallingFileData callData);
+    template <typename elem_t>
     ListErrorCode VerifyList_  (List <elem_t> *list);
     template <typename elem_t>
     ListErrorCode DumpList_    (List <elem_t> *list, char *logFolder, CallingFileData callData);
+    template <typename elem_t, typename comparator_t>
+    ListErrorCode SortList_    (List <elem_t> *list, comparator_t comparator, CallingFileData callData);
+    template <typename elem_t, typename comparator_t>
+    ListErrorCode SortListByRelinking_ (List <elem_t> *list, comparator_t comparator, CallingFileData callData);
+    template <typename elem_t, typename comparator_t>
+    ListErrorCode SortListPhysically_  (List <elem_t> *list, comparator_t comparator, CallingFileData callData);
     template <typename elem_t>
-    ListErrorCode FindValueInListSlowImplementation_ (List <elem_t> *list, elem_t value, ssize_t *index, CallingFileData callData);
+    ListErrorCode FindValueInListSlowImplementation_ (List <elem_t> *list, const NonDeduced <elem_t> &value, ssize_t *index, CallingFileData callData);
 
     ListErrorCode ClearHtmlFile ();
 
@@ -64,10 +93,15 @@ namespace LinkedList {
 
     #define InitList(list, capacity)                          InitList_    (list, capacity, CreateCallingFileData)
     #define InsertAfter(list, insertIndex, newIndex, element) InsertAfter_ (list, insertIndex, newIndex, element, CreateCallingFileData)
+    #define EmplaceAfter(list, insertIndex, newIndex, ...)    EmplaceAfter_ (list, insertIndex, newIndex, CreateCallingFileData, ##__VA_ARGS__)
     #define DeleteValue(list, deleteIndex)                    DeleteValue_ (list, deleteIndex, CreateCallingFileData)
+    #define MoveAfter(list, insertIndex, moveIndex)           MoveAfter_   (list, insertIndex, moveIndex, CreateCallingFileData)
     #define DumpList(list, logFolder)                         DumpList_    (list, logFolder, CreateCallingFileData)
     #define DestroyList(list)                                 DestroyList_ (list)
     #define VerifyList(list)                                  VerifyList_  (list)
+    #define SortList(list, comparator)                        SortList_    (list, comparator, CreateCallingFileData)
+    #define SortListByRelinking(list, comparator)             SortListByRelinking_ (list, comparator, CreateCallingFileData)
+    #define SortListPhysically(list, comparator)              SortListPhysically_  (list, comparator, CreateCallingFileData)
 
     #define FindValueInListSlowImplementation(list, value, index)\
                 FindValueInListSlowImplementation_ (list, value, index, CreateCallingFileData);
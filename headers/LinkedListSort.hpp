@@ -0,0 +1,220 @@
+#ifndef LINKED_LIST_SORT_HPP_
+#define LINKED_LIST_SORT_HPP_
+
+#include <algorithm>
+#include <new>
+#include <sys/types.h>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <LinkedList.hpp>
+
+namespace LinkedList {
+    const size_t MIN_ELEMENTS_PER_SORT_THREAD = 1 << 14;
+
+    // Bottom-up merge sort over the next links: indices stay valid, payloads never move and only O(1) memory is used
+    template <typename elem_t, typename comparator_t>
+    ListErrorCode SortListByRelinking_ (List <elem_t> *list, comparator_t comparator, CallingFileData callData) {
+        Verification (list, callData);
+
+        ssize_t *next = list->next;
+        ssize_t  head = next [0];
+
+        if (head == 0) {
+            return NO_LIST_ERRORS;
+        }
+
+        for (size_t mergeSize = 1; ; mergeSize *= 2) {
+            ssize_t left        = head;
+            ssize_t tail        = 0;
+            size_t  mergesCount = 0;
+
+            head = 0;
+
+            while (left != 0) {
+                mergesCount++;
+
+                ssize_t right     = left;
+                size_t  leftSize  = 0;
+
+                while (leftSize < mergeSize && right != 0) {
+                    leftSize++;
+                    right = next [right];
+                }
+
+                size_t rightSize = mergeSize;
+
+                while (leftSize > 0 || (rightSize > 0 && right != 0)) {
+                    ssize_t merged = 0;
+
+                    // Left run wins ties, so the sort is stable
+                    if (leftSize == 0 || (rightSize > 0 && right != 0 && comparator (list->data [right], list->data [left]))) {
+                        merged = right;
+                        right  = next [right];
+                        rightSize--;
+                    } else {
+                        merged = left;
+                        left   = next [left];
+                        leftSize--;
+                    }
+
+                    if (tail != 0) {
+                        next [tail] = merged;
+                    } else {
+                        head = merged;
+                    }
+
+                    tail = merged;
+                }
+
+                left = right;
+            }
+
+            next [tail] = 0;
+
+            if (mergesCount <= 1) {
+                break;
+            }
+        }
+
+        ssize_t previous = 0;
+
+        for (ssize_t nodeIndex = head; nodeIndex != 0; nodeIndex = next [nodeIndex]) {
+            list->prev [nodeIndex] = previous;
+            previous = nodeIndex;
+        }
+
+        next       [0] = head;
+        list->prev [0] = previous;
+
+        if (list->orderIndex) {
+            RebuildOrderIndex_ (list);
+        }
+
+        return NO_LIST_ERRORS;
+    }
+
+    // Moves the payloads into logical order, sorts them on several threads and rewrites next/prev as a linear list.
+    // Every node gets a new index: node k of the sorted list ends up in slot k
+    template <typename elem_t, typename comparator_t>
+    ListErrorCode SortListPhysically_ (List <elem_t> *list, comparator_t comparator, CallingFileData callData) {
+        Verification (list, callData);
+
+        size_t nodesCount = 0;
+
+        for (ssize_t nodeIndex = list->next [0]; nodeIndex != 0; nodeIndex = list->next [nodeIndex]) {
+            nodesCount++;
+        }
+
+        ssize_t *order      = (ssize_t *) calloc (nodesCount + 1, sizeof (ssize_t));
+        elem_t  *sortedData = AllocateElements_ <elem_t> ((size_t) list->capacity);
+
+        if (!order || !sortedData) {
+            free (order);
+            free (sortedData);
+
+            return SortListByRelinking_ (list, comparator, callData);
+        }
+
+        size_t orderIndex = 0;
+
+        for (ssize_t nodeIndex = list->next [0]; nodeIndex != 0; nodeIndex = list->next [nodeIndex]) {
+            order [orderIndex++] = nodeIndex;
+        }
+
+        size_t hardwareThreads = std::max (std::thread::hardware_concurrency (), 1u);
+        size_t threadsCount    = std::max (std::min (hardwareThreads, nodesCount / MIN_ELEMENTS_PER_SORT_THREAD), (size_t) 1);
+
+        auto RunOnChunks = [&] (auto chunkFunction) {
+            std::vector <std::thread> workers (threadsCount);
+
+            for (size_t threadIndex = 0; threadIndex < threadsCount; threadIndex++) {
+                size_t chunkBegin = nodesCount *  threadIndex      / threadsCount;
+                size_t chunkEnd   = nodesCount * (threadIndex + 1) / threadsCount;
+
+                if (threadIndex + 1 == threadsCount) {
+                    chunkFunction (chunkBegin, chunkEnd);
+                } else {
+                    workers [threadIndex] = std::thread (chunkFunction, chunkBegin, chunkEnd);
+                }
+            }
+
+            for (size_t threadIndex = 0; threadIndex + 1 < threadsCount; threadIndex++) {
+                workers [threadIndex].join ();
+            }
+        };
+
+        elem_t *sortedElements = sortedData + 1;
+
+        // Gather: random reads are spread over the threads, writes are sequential within every chunk
+        RunOnChunks ([&] (size_t chunkBegin, size_t chunkEnd) {
+            for (size_t position = chunkBegin; position < chunkEnd; position++) {
+                elem_t *element = list->data + order [position];
+
+                if constexpr (std::is_trivially_copyable_v <elem_t>) {
+                    memcpy ((void *) (sortedElements + position), element, sizeof (elem_t));
+                } else {
+                    new (sortedElements + position) elem_t (std::move (*element));
+                    element->~elem_t ();
+                }
+            }
+        });
+
+        RunOnChunks ([&] (size_t chunkBegin, size_t chunkEnd) {
+            std::stable_sort (sortedElements + chunkBegin, sortedElements + chunkEnd, comparator);
+        });
+
+        for (size_t mergedChunks = 1; mergedChunks < threadsCount; mergedChunks *= 2) {
+            for (size_t threadIndex = 0; threadIndex + mergedChunks < threadsCount; threadIndex += 2 * mergedChunks) {
+                size_t mergeBegin  = nodesCount *  threadIndex                                              / threadsCount;
+                size_t mergeMiddle = nodesCount * (threadIndex + mergedChunks)                              / threadsCount;
+                size_t mergeEnd    = nodesCount * std::min (threadIndex + 2 * mergedChunks, threadsCount) / threadsCount;
+
+                std::inplace_merge (sortedElements + mergeBegin, sortedElements + mergeMiddle, sortedElements + mergeEnd, comparator);
+            }
+        }
+
+        free (order);
+        free (list->data);
+
+        list->data = sortedData;
+
+        ssize_t lastNode = (ssize_t) nodesCount;
+
+        for (ssize_t nodeIndex = 1; nodeIndex <= lastNode; nodeIndex++) {
+            list->next [nodeIndex] = nodeIndex + 1;
+            list->prev [nodeIndex] = nodeIndex - 1;
+        }
+
+        for (ssize_t nodeIndex = lastNode + 1; nodeIndex < list->capacity; nodeIndex++) {
+            list->next [nodeIndex] = (nodeIndex + 1) % list->capacity;
+            list->prev [nodeIndex] = -1;
+        }
+
+        if (lastNode > 0) {
+            list->next [lastNode] = 0;
+        }
+
+        list->next [0] = lastNode > 0 ? 1 : 0;
+        list->prev [0] = lastNode;
+
+        list->freeElem = lastNode + 1 < list->capacity ? lastNode + 1 : 0;
+
+        if (list->orderIndex) {
+            RebuildOrderIndex_ (list);
+        }
+
+        return NO_LIST_ERRORS;
+    }
+
+    // Keeps every index valid, so it always relinks. SortListPhysically is faster for small payloads but renumbers
+    // the nodes and has to be asked for explicitly
+    template <typename elem_t, typename comparator_t>
+    ListErrorCode SortList_ (List <elem_t> *list, comparator_t comparator, CallingFileData callData) {
+        return SortListByRelinking_ (list, comparator, callData);
+    }
+}
+
+#endif
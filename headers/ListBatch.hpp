@@ -0,0 +1,474 @@
+#ifndef LIST_BATCH_HPP_
+#define LIST_BATCH_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <sys/types.h>
+#include <type_traits>
+#include <utility>
+
+#include <LinkedList.hpp>
+
+namespace LinkedList {
+    const size_t MIN_BATCH_CAPACITY   = 64;
+    const size_t BATCH_PREFETCH_AHEAD = 8;
+    const size_t BATCH_RADIX_BITS     = 11;
+    const size_t BATCH_RADIX_BUCKETS  = (size_t) 1 << BATCH_RADIX_BITS;
+
+    enum BatchOperationType {
+        BATCH_INSERT_AFTER = 0,
+        BATCH_DELETE       = 1,
+    };
+
+    const ssize_t BATCH_SKIPPED = -1;
+
+    // Target of an operation that refers to the node created by the operationIndex-th operation of the same batch
+    inline ssize_t BatchPlaceholder (size_t operationIndex) {
+        return -1 - (ssize_t) operationIndex;
+    }
+
+    // Deletes carry no payload, so element is raw storage that only inserts construct
+    template <typename elem_t>
+    struct BatchOperation {
+        BatchOperationType type    = BATCH_INSERT_AFTER;
+        ssize_t            target  = 0;
+        ssize_t            result  = BATCH_SKIPPED; // Created index for inserts, target for deletes
+
+        alignas (elem_t) unsigned char element [sizeof (elem_t)];
+    };
+
+    template <typename elem_t>
+    elem_t *BatchElement_ (BatchOperation <elem_t> *operation) {
+        return std::launder ((elem_t *) operation->element);
+    }
+
+    template <typename elem_t>
+    void DestroyBatchOperation_ (BatchOperation <elem_t> *operation) {
+        if constexpr (!std::is_trivially_destructible_v <elem_t>) {
+            if (operation->type == BATCH_INSERT_AFTER) {
+                BatchElement_ (operation)->~elem_t ();
+            }
+        }
+    }
+
+    // Non-negative targets must name live nodes, new nodes are reached through BatchPlaceholder.
+    // Applying moves the insert payloads into the list, so an applied batch only serves BatchResult until ClearBatch
+    template <typename elem_t>
+    struct ListBatch {
+        BatchOperation <elem_t> *operations   = NULL;
+        size_t                   size         = 0;
+        size_t                   capacity     = 0;
+
+        size_t                   appliedCount = 0;
+        size_t                   skippedCount = 0;
+        bool                     isApplied    = false;
+    };
+
+    template <typename elem_t>
+    ListErrorCode ReserveBatch_ (ListBatch <elem_t> *batch, size_t capacity) {
+        if (capacity <= batch->capacity) {
+            return NO_LIST_ERRORS;
+        }
+
+        BatchOperation <elem_t> *operations = AllocateElements_ <BatchOperation <elem_t>> (capacity);
+
+        if (!operations) {
+            return DATA_NULL_POINTER;
+        }
+
+        for (size_t operationIndex = 0; operationIndex < batch->size; operationIndex++) {
+            BatchOperation <elem_t> *operation = batch->operations + operationIndex;
+
+            operations [operationIndex].type   = operation->type;
+            operations [operationIndex].target = operation->target;
+            operations [operationIndex].result = operation->result;
+
+            if (operation->type == BATCH_INSERT_AFTER) {
+                new (operations [operationIndex].element) elem_t (std::move (*BatchElement_ (operation)));
+            }
+
+            DestroyBatchOperation_ (operation);
+        }
+
+        free (batch->operations);
+
+        batch->operations = operations;
+        batch->capacity   = capacity;
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t>
+    ListErrorCode InitBatch_ (ListBatch <elem_t> *batch, size_t capacity) {
+        if (!batch) {
+            return LIST_NULL_POINTER;
+        }
+
+        *batch = {};
+
+        return ReserveBatch_ (batch, std::max (capacity, MIN_BATCH_CAPACITY));
+    }
+
+    template <typename elem_t>
+    void ClearBatch_ (ListBatch <elem_t> *batch) {
+        for (size_t operationIndex = 0; operationIndex < batch->size; operationIndex++) {
+            DestroyBatchOperation_ (batch->operations + operationIndex);
+        }
+
+        batch->size         = 0;
+        batch->appliedCount = 0;
+        batch->skippedCount = 0;
+        batch->isApplied    = false;
+    }
+
+    template <typename elem_t>
+    ListErrorCode DestroyBatch_ (ListBatch <elem_t> *batch) {
+        if (!batch) {
+            return LIST_NULL_POINTER;
+        }
+
+        ClearBatch_ (batch);
+
+        free (batch->operations);
+
+        *batch = {};
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, typename... Args>
+    ListErrorCode EnqueueBatchOperation_ (ListBatch <elem_t> *batch, BatchOperationType type, ssize_t target, size_t *operationIndex, Args &&... args) {
+        if (!batch) {
+            return LIST_NULL_POINTER;
+        }
+
+        // A zeroed batch that never went through InitBatch has nothing to grow from
+        if (!batch->operations) {
+            return DATA_NULL_POINTER;
+        }
+
+        if (batch->isApplied) {
+            return BATCH_ALREADY_APPLIED;
+        }
+
+        if (batch->size == batch->capacity) {
+            ListErrorCode errorCode = ReserveBatch_ (batch, batch->capacity * REALLOC_SCALE);
+
+            if (errorCode != NO_LIST_ERRORS) {
+                return errorCode;
+            }
+        }
+
+        BatchOperation <elem_t> *operation = batch->operations + batch->size;
+
+        operation->type   = type;
+        operation->target = target;
+        operation->result = BATCH_SKIPPED;
+
+        // Only inserts pass a payload
+        if constexpr (sizeof... (Args) > 0) {
+            new (operation->element) elem_t (std::forward <Args> (args)...);
+        }
+
+        if (operationIndex) {
+            *operationIndex = batch->size;
+        }
+
+        batch->size++;
+
+        return NO_LIST_ERRORS;
+    }
+
+    // *operationIndex may be passed to BatchPlaceholder to target the created node later in the same batch
+    template <typename elem_t>
+    ListErrorCode BatchInsertAfter_ (ListBatch <elem_t> *batch, ssize_t insertIndex, const NonDeduced <elem_t> &element, size_t *operationIndex) {
+        return EnqueueBatchOperation_ (batch, BATCH_INSERT_AFTER, insertIndex, operationIndex, element);
+    }
+
+    template <typename elem_t>
+    ListErrorCode BatchDelete_ (ListBatch <elem_t> *batch, ssize_t deleteIndex, size_t *operationIndex) {
+        return EnqueueBatchOperation_ (batch, BATCH_DELETE, deleteIndex, operationIndex);
+    }
+
+    // Created index of an insert or the deleted index of a delete; BATCH_SKIPPED if the operation was not applied
+    template <typename elem_t>
+    ssize_t BatchResult (const ListBatch <elem_t> *batch, size_t operationIndex) {
+        return batch->operations [operationIndex].result;
+    }
+
+    // Node named by the target of an operation or BATCH_SKIPPED. A placeholder is resolved only once its creator
+    // has run, that is when the creator comes before executedCount
+    template <typename elem_t>
+    ssize_t ResolveBatchTarget_ (const ListBatch <elem_t> *batch, size_t operationIndex, size_t executedCount) {
+        ssize_t target = batch->operations [operationIndex].target;
+
+        if (target >= 0) {
+            return target;
+        }
+
+        size_t creatorIndex = (size_t) (-1 - target);
+
+        if (creatorIndex >= executedCount || creatorIndex >= operationIndex || batch->operations [creatorIndex].type != BATCH_INSERT_AFTER) {
+            return BATCH_SKIPPED;
+        }
+
+        return batch->operations [creatorIndex].result;
+    }
+
+    // Executes one operation against an already verified list with the same checks as InsertAfter_ and DeleteValue_.
+    // Deleted slots are pushed onto freedSlots: the free list itself or a chain that joins it later
+    template <typename elem_t>
+    void ApplyBatchOperation_ (List <elem_t> *list, ListBatch <elem_t> *batch, size_t operationIndex, ssize_t *freedSlots) {
+        BatchOperation <elem_t> *operation = batch->operations + operationIndex;
+        ssize_t                  target    = ResolveBatchTarget_ (batch, operationIndex, operationIndex);
+        bool                     isDelete  = operation->type == BATCH_DELETE;
+
+        operation->result = BATCH_SKIPPED;
+
+        if (target < (isDelete ? 1 : 0) || target >= list->capacity || list->prev [target] == -1 || (!isDelete && list->freeElem == 0)) {
+            batch->skippedCount++;
+            return;
+        }
+
+        if (isDelete) {
+            list->prev [list->next [target]] = list->prev [target];
+            list->next [list->prev [target]] = list->next [target];
+
+            if constexpr (!std::is_trivially_destructible_v <elem_t>) {
+                list->data [target].~elem_t ();
+            }
+
+            if (list->orderIndex) {
+                OrderIndexErase_ (list->orderIndex, target);
+            }
+
+            list->next [target] = *freedSlots;
+            list->prev [target] = -1;
+            *freedSlots         = target;
+        } else {
+            ssize_t newIndex = list->freeElem;
+
+            new (list->data + newIndex) elem_t (std::move (*BatchElement_ (operation)));
+
+            LinkAcquiredSlot_ (list, target, newIndex);
+
+            // The free list is a chain of misses of its own: the slot the next insert takes is known right now
+            __builtin_prefetch (list->next + list->freeElem, 1);
+            __builtin_prefetch (list->prev + list->freeElem, 1);
+            __builtin_prefetch (list->data + list->freeElem, 1);
+
+            target = newIndex;
+        }
+
+        operation->result = target;
+        batch->appliedCount++;
+    }
+
+    // Runs the operations listed in order (all of them in enqueue order when order is NULL) behind a two stage
+    // prefetch pipeline: the links of a target first, then its neighbours once those links have arrived.
+    // It stays inside this loop: GCC treats a function that only prefetches as pure and drops the call
+    template <typename elem_t>
+    void RunBatchOperations_ (List <elem_t> *list, ListBatch <elem_t> *batch, const size_t *order, size_t count, ssize_t *freedSlots) {
+        for (size_t position = 0; position < count; position++) {
+            size_t operationIndex = order ? order [position] : position;
+            size_t farPosition    = position + 2 * BATCH_PREFETCH_AHEAD;
+
+            if (farPosition < count) {
+                ssize_t farTarget = ResolveBatchTarget_ (batch, order ? order [farPosition] : farPosition, operationIndex);
+
+                if (farTarget >= 0 && farTarget < list->capacity) {
+                    __builtin_prefetch (list->next + farTarget, 1);
+                    __builtin_prefetch (list->prev + farTarget, 1);
+                }
+            }
+
+            size_t nearPosition = position + BATCH_PREFETCH_AHEAD;
+
+            if (nearPosition < count) {
+                size_t  nearIndex  = order ? order [nearPosition] : nearPosition;
+                ssize_t nearTarget = ResolveBatchTarget_ (batch, nearIndex, operationIndex);
+
+                if (nearTarget >= 0 && nearTarget < list->capacity && list->prev [nearTarget] != -1) {
+                    __builtin_prefetch (list->prev + list->next [nearTarget], 1);
+
+                    if (batch->operations [nearIndex].type == BATCH_DELETE) {
+                        __builtin_prefetch (list->next + list->prev [nearTarget], 1);
+                    }
+                }
+            }
+
+            ApplyBatchOperation_ (list, batch, operationIndex, freedSlots);
+        }
+    }
+
+    // Grouped run of ApplyBatchGrouped_. Returns false without touching the list when the free list can't give every
+    // insert a slot or the order could not be allocated
+    template <typename elem_t>
+    bool RunBatchGrouped_ (List <elem_t> *list, ListBatch <elem_t> *batch) {
+        size_t insertsCount = 0;
+
+        for (size_t operationIndex = 0; operationIndex < batch->size; operationIndex++) {
+            insertsCount += batch->operations [operationIndex].type == BATCH_INSERT_AFTER;
+        }
+
+        // These are the slots the inserts take, so the walk also brings their links into the cache
+        ssize_t freeSlot = list->freeElem;
+
+        for (size_t slotNumber = 0; slotNumber < insertsCount; slotNumber++) {
+            if (freeSlot <= 0 || freeSlot >= list->capacity) {
+                return false;
+            }
+
+            freeSlot = list->next [freeSlot];
+        }
+
+        size_t *orderBuffer = (size_t *) calloc (2 * batch->size + 1, sizeof (size_t));
+
+        if (!orderBuffer) {
+            return false;
+        }
+
+        size_t *order  = orderBuffer;
+        size_t *sorted = orderBuffer + batch->size;
+
+        // Targets that are not live now stay skipped: only a slot that was free before the batch could revive them
+        size_t groupedCount = 0;
+
+        for (size_t operationIndex = 0; operationIndex < batch->size; operationIndex++) {
+            BatchOperation <elem_t> *operation = batch->operations + operationIndex;
+
+            if (operation->target < 0) {
+                continue;
+            }
+
+            if (operation->target >= list->capacity || list->prev [operation->target] == -1) {
+                operation->result = BATCH_SKIPPED;
+                batch->skippedCount++;
+                continue;
+            }
+
+            order [groupedCount++] = operationIndex;
+        }
+
+        // LSD radix sort by target. It is stable, so operations on the same node keep their enqueue order
+        size_t bucketStarts [BATCH_RADIX_BUCKETS] = {};
+
+        for (size_t shift = 0; ((size_t) list->capacity - 1) >> shift != 0; shift += BATCH_RADIX_BITS) {
+            std::fill (bucketStarts, bucketStarts + BATCH_RADIX_BUCKETS, 0);
+
+            #define RadixDigit(operationIndex) (((size_t) batch->operations [operationIndex].target >> shift) & (BATCH_RADIX_BUCKETS - 1))
+
+            for (size_t position = 0; position < groupedCount; position++) {
+                bucketStarts [RadixDigit (order [position])]++;
+            }
+
+            for (size_t bucket = 0, bucketStart = 0; bucket < BATCH_RADIX_BUCKETS; bucket++) {
+                size_t bucketSize = bucketStarts [bucket];
+
+                bucketStarts [bucket] = bucketStart;
+                bucketStart          += bucketSize;
+            }
+
+            for (size_t position = 0; position < groupedCount; position++) {
+                sorted [bucketStarts [RadixDigit (order [position])]++] = order [position];
+            }
+
+            #undef RadixDigit
+
+            std::swap (order, sorted);
+        }
+
+        // A slot freed here is only taken once the sweep has passed its index, so no later target can name it
+        RunBatchOperations_ (list, batch, order, groupedCount, &list->freeElem);
+
+        size_t placeholdersCount = 0;
+
+        for (size_t operationIndex = 0; operationIndex < batch->size; operationIndex++) {
+            if (batch->operations [operationIndex].target < 0) {
+                sorted [placeholdersCount++] = operationIndex;
+            }
+        }
+
+        // Nodes the batch created and deleted keep their slots until the end, so a stale placeholder is skipped
+        ssize_t freedSlots = 0;
+        ssize_t freedTail  = 0;
+
+        RunBatchOperations_ (list, batch, sorted, placeholdersCount, &freedSlots);
+
+        free (orderBuffer);
+
+        for (ssize_t slot = freedSlots; slot != 0; slot = list->next [slot]) {
+            freedTail = slot;
+        }
+
+        if (freedTail != 0) {
+            list->next [freedTail] = list->freeElem;
+            list->freeElem         = freedSlots;
+        }
+
+        return true;
+    }
+
+    // Verifies the list once and runs the operations in enqueue order, prefetching the nodes of the ones ahead.
+    // The result equals calling InsertAfter_ and DeleteValue_ one by one with every placeholder replaced by the
+    // index its insert returned, except that an operation that would fail is skipped and counted instead.
+    // Freed slots are reused right away, so a stale non-negative target may name a node created by the batch
+    template <typename elem_t>
+    ListErrorCode ApplyBatch_ (List <elem_t> *list, ListBatch <elem_t> *batch, CallingFileData callData) {
+        assert (batch);
+
+        if (batch->isApplied) {
+            return BATCH_ALREADY_APPLIED;
+        }
+
+        Verification (list, callData);
+
+        batch->appliedCount = 0;
+        batch->skippedCount = 0;
+        batch->isApplied    = true;
+
+        RunBatchOperations_ (list, batch, (const size_t *) NULL, batch->size, &list->freeElem);
+
+        return NO_LIST_ERRORS;
+    }
+
+    // ApplyBatch_ that sweeps the list by index: when the free list holds a slot for every insert, operations on
+    // nodes that are live before the batch run sorted by target index and operations on placeholders after them in
+    // enqueue order. Node order and contents are those of InsertAfter_ and DeleteValue_ called one by one, but
+    // created indices differ and a target only ever names the node it named at enqueue time: once deleted, it stays
+    // deleted for the rest of the batch. Otherwise it falls back to ApplyBatch_.
+    // Sorting and visiting the operations out of order cost more than the sweep saves on the shuffled lists of
+    // bench/ListBench.cpp, so ApplyBatch_ stays the default
+    template <typename elem_t>
+    ListErrorCode ApplyBatchGrouped_ (List <elem_t> *list, ListBatch <elem_t> *batch, CallingFileData callData) {
+        assert (batch);
+
+        if (batch->isApplied) {
+            return BATCH_ALREADY_APPLIED;
+        }
+
+        Verification (list, callData);
+
+        batch->appliedCount = 0;
+        batch->skippedCount = 0;
+        batch->isApplied    = true;
+
+        if (!RunBatchGrouped_ (list, batch)) {
+            RunBatchOperations_ (list, batch, (const size_t *) NULL, batch->size, &list->freeElem);
+        }
+
+        return NO_LIST_ERRORS;
+    }
+
+    #define InitBatch(batch, capacity)                                    InitBatch_         (batch, capacity)
+    #define DestroyBatch(batch)                                           DestroyBatch_      (batch)
+    #define ClearBatch(batch)                                             ClearBatch_        (batch)
+    #define BatchInsertAfter(batch, insertIndex, element, operationIndex) BatchInsertAfter_  (batch, insertIndex, element, operationIndex)
+    #define BatchDelete(batch, deleteIndex, operationIndex)               BatchDelete_       (batch, deleteIndex, operationIndex)
+    #define ApplyBatch(list, batch)                                       ApplyBatch_        (list, batch, CreateCallingFileData)
+    #define ApplyBatchGrouped(list, batch)                                ApplyBatchGrouped_ (list, batch, CreateCallingFileData)
+}
+
+#endif
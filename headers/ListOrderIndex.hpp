@@ -0,0 +1,338 @@
+#ifndef LIST_ORDER_INDEX_HPP_
+#define LIST_ORDER_INDEX_HPP_
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <sys/types.h>
+
+#include <LinkedListDefinitions.hpp>
+
+namespace LinkedList {
+    // Implicit treap over the logical order: tree nodes share their numbers with list nodes, in-order traversal
+    // is the list order and subtree sizes give positions. 0 is the null node, the list sentinel is never in the tree
+    // All fields of a tree node live together: a 40-byte node spans one or two cache lines, so a descent touches at most
+    // two lines per level instead of one per field array
+    struct OrderIndexNode {
+        ssize_t  left;
+        ssize_t  right;
+        ssize_t  parent;
+        ssize_t  size;
+        uint32_t priority;
+    };
+
+    struct ListOrderIndex {
+        OrderIndexNode *nodes       = NULL;
+
+        ssize_t         root        = 0;
+        uint64_t        randomState = 0x9e3779b97f4a7c15ULL;
+    };
+
+    inline uint32_t NextOrderPriority_ (ListOrderIndex *orderIndex) {
+        orderIndex->randomState ^= orderIndex->randomState << 13;
+        orderIndex->randomState ^= orderIndex->randomState >> 7;
+        orderIndex->randomState ^= orderIndex->randomState << 17;
+
+        return (uint32_t) (orderIndex->randomState >> 32);
+    }
+
+    inline void UpdateOrderSize_ (OrderIndexNode *nodes, ssize_t node) {
+        nodes [node].size = 1 + nodes [nodes [node].left].size + nodes [nodes [node].right].size;
+    }
+
+    // Lifts node above its parent keeping the in-order sequence
+    inline void RotateOrderNodeUp_ (ListOrderIndex *orderIndex, ssize_t node) {
+        OrderIndexNode *nodes = orderIndex->nodes;
+
+        ssize_t parentNode = nodes [node].parent;
+        ssize_t grandNode  = nodes [parentNode].parent;
+        ssize_t movedNode  = 0;
+
+        if (nodes [parentNode].left == node) {
+            movedNode               = nodes [node].right;
+            nodes [parentNode].left = movedNode;
+            nodes [node].right      = parentNode;
+        } else {
+            movedNode                = nodes [node].left;
+            nodes [parentNode].right = movedNode;
+            nodes [node].left        = parentNode;
+        }
+
+        if (movedNode != 0) {
+            nodes [movedNode].parent = parentNode;
+        }
+
+        nodes [parentNode].parent = node;
+        nodes [node].parent       = grandNode;
+
+        if (grandNode == 0) {
+            orderIndex->root = node;
+        } else if (nodes [grandNode].left == parentNode) {
+            nodes [grandNode].left  = node;
+        } else {
+            nodes [grandNode].right = node;
+        }
+
+        UpdateOrderSize_ (nodes, parentNode);
+        UpdateOrderSize_ (nodes, node);
+    }
+
+    // Puts newNode right after insertNode in the order (insertNode 0 means at the head)
+    inline void OrderIndexInsertAfter_ (ListOrderIndex *orderIndex, ssize_t insertNode, ssize_t newNode) {
+        OrderIndexNode *nodes = orderIndex->nodes;
+
+        nodes [newNode] = {0, 0, 0, 1, NextOrderPriority_ (orderIndex)};
+
+        if (orderIndex->root == 0) {
+            orderIndex->root = newNode;
+            return;
+        }
+
+        ssize_t attachNode = 0;
+
+        if (insertNode != 0 && nodes [insertNode].right == 0) {
+            attachNode               = insertNode;
+            nodes [attachNode].right = newNode;
+        } else {
+            attachNode = insertNode != 0 ? nodes [insertNode].right : orderIndex->root;
+
+            while (nodes [attachNode].left != 0) {
+                attachNode = nodes [attachNode].left;
+            }
+
+            nodes [attachNode].left = newNode;
+        }
+
+        nodes [newNode].parent = attachNode;
+
+        for (ssize_t node = attachNode; node != 0; node = nodes [node].parent) {
+            nodes [node].size++;
+        }
+
+        while (nodes [newNode].parent != 0 && nodes [nodes [newNode].parent].priority < nodes [newNode].priority) {
+            RotateOrderNodeUp_ (orderIndex, newNode);
+        }
+    }
+
+    inline void OrderIndexErase_ (ListOrderIndex *orderIndex, ssize_t node) {
+        OrderIndexNode *nodes = orderIndex->nodes;
+
+        // Sink the node to a leaf, lifting the child with the higher priority each time
+        while (nodes [node].left != 0 || nodes [node].right != 0) {
+            ssize_t leftNode  = nodes [node].left;
+            ssize_t rightNode = nodes [node].right;
+
+            bool isLeftLifted = rightNode == 0 || (leftNode != 0 && nodes [leftNode].priority > nodes [rightNode].priority);
+
+            RotateOrderNodeUp_ (orderIndex, isLeftLifted ? leftNode : rightNode);
+        }
+
+        ssize_t parentNode = nodes [node].parent;
+
+        if (parentNode == 0) {
+            orderIndex->root = 0;
+        } else if (nodes [parentNode].left == node) {
+            nodes [parentNode].left  = 0;
+        } else {
+            nodes [parentNode].right = 0;
+        }
+
+        for (ssize_t ancestor = parentNode; ancestor != 0; ancestor = nodes [ancestor].parent) {
+            nodes [ancestor].size--;
+        }
+
+        nodes [node] = {};
+    }
+
+    // 0-based position of a node that is in the tree
+    inline ssize_t OrderIndexRank_ (const ListOrderIndex *orderIndex, ssize_t node) {
+        const OrderIndexNode *nodes = orderIndex->nodes;
+
+        ssize_t rank = nodes [nodes [node].left].size;
+
+        for (ssize_t parentNode = nodes [node].parent; parentNode != 0; node = parentNode, parentNode = nodes [node].parent) {
+            if (nodes [parentNode].right == node) {
+                rank += nodes [nodes [parentNode].left].size + 1;
+            }
+        }
+
+        return rank;
+    }
+
+    // Node at a 0-based position or 0 if the position is past the end
+    inline ssize_t OrderIndexAt_ (const ListOrderIndex *orderIndex, ssize_t position) {
+        const OrderIndexNode *nodes = orderIndex->nodes;
+
+        ssize_t node = orderIndex->root;
+
+        while (node != 0) {
+            ssize_t leftSize = nodes [nodes [node].left].size;
+
+            if (position < leftSize) {
+                node = nodes [node].left;
+            } else if (position == leftSize) {
+                return node;
+            } else {
+                position -= leftSize + 1;
+                node = nodes [node].right;
+            }
+        }
+
+        return 0;
+    }
+
+    // Builds the treap for the current order in O(n): a Cartesian tree over random priorities, keeping the right
+    // spine in the parent links. A node leaves the spine complete, so its size is final at that moment
+    template <typename elem_t>
+    void RebuildOrderIndex_ (List <elem_t> *list) {
+        ListOrderIndex *orderIndex = list->orderIndex;
+        OrderIndexNode *nodes      = orderIndex->nodes;
+
+        orderIndex->root = 0;
+
+        ssize_t rightmostNode = 0;
+
+        for (ssize_t node = list->next [0]; node != 0; node = list->next [node]) {
+            nodes [node] = {0, 0, 0, 0, NextOrderPriority_ (orderIndex)};
+
+            ssize_t spineNode  = rightmostNode;
+            ssize_t poppedNode = 0;
+
+            while (spineNode != 0 && nodes [spineNode].priority < nodes [node].priority) {
+                UpdateOrderSize_ (nodes, spineNode);
+
+                poppedNode = spineNode;
+                spineNode  = nodes [spineNode].parent;
+            }
+
+            nodes [node].left   = poppedNode;
+            nodes [node].parent = spineNode;
+
+            if (poppedNode != 0) {
+                nodes [poppedNode].parent = node;
+            }
+
+            if (spineNode != 0) {
+                nodes [spineNode].right = node;
+            } else {
+                orderIndex->root = node;
+            }
+
+            rightmostNode = node;
+        }
+
+        for (ssize_t spineNode = rightmostNode; spineNode != 0; spineNode = nodes [spineNode].parent) {
+            UpdateOrderSize_ (nodes, spineNode);
+        }
+    }
+
+    template <typename elem_t>
+    ListErrorCode DisableOrderIndex_ (List <elem_t> *list) {
+        if (!list) {
+            return LIST_NULL_POINTER;
+        }
+
+        if (list->orderIndex) {
+            free (list->orderIndex->nodes);
+            free (list->orderIndex);
+
+            list->orderIndex = NULL;
+        }
+
+        return NO_LIST_ERRORS;
+    }
+
+    // Costs 40 bytes per slot; from here on InsertAfter_, DeleteValue_, MoveAfter_ and the sorts keep it up to date
+    template <typename elem_t>
+    ListErrorCode EnableOrderIndex_ (List <elem_t> *list, CallingFileData callData) {
+        if (!list) {
+            return LIST_NULL_POINTER;
+        }
+
+        if (list->orderIndex) {
+            return NO_LIST_ERRORS;
+        }
+
+        ListOrderIndex *orderIndex = (ListOrderIndex *) calloc (1, sizeof (ListOrderIndex));
+
+        if (!orderIndex) {
+            return DATA_NULL_POINTER;
+        }
+
+        *orderIndex = {};
+
+        orderIndex->nodes = (OrderIndexNode *) calloc ((size_t) list->capacity, sizeof (OrderIndexNode));
+
+        list->orderIndex = orderIndex;
+
+        if (!orderIndex->nodes) {
+            DisableOrderIndex_ (list);
+
+            return DATA_NULL_POINTER;
+        }
+
+        RebuildOrderIndex_ (list);
+
+        return NO_LIST_ERRORS;
+    }
+
+    // Node at a 0-based logical position; *index is 0 if the position is past the tail.
+    // Walks from the head when the order index is disabled
+    template <typename elem_t>
+    ListErrorCode ListAt_ (List <elem_t> *list, ssize_t position, ssize_t *index, CallingFileData callData) {
+        assert (index);
+
+        if (position < 0) {
+            return WRONG_INDEX;
+        }
+
+        if (list->orderIndex) {
+            *index = OrderIndexAt_ (list->orderIndex, position);
+
+            return NO_LIST_ERRORS;
+        }
+
+        ssize_t node = list->next [0];
+
+        for (ssize_t skipped = 0; skipped < position && node != 0; skipped++) {
+            node = list->next [node];
+        }
+
+        *index = node;
+
+        return NO_LIST_ERRORS;
+    }
+
+    // 0-based logical position of a node. Walks back to the head when the order index is disabled
+    template <typename elem_t>
+    ListErrorCode ListRankOf_ (List <elem_t> *list, ssize_t index, ssize_t *position, CallingFileData callData) {
+        assert (position);
+
+        if (index <= 0 || index >= list->capacity || list->prev [index] == -1) {
+            return WRONG_INDEX;
+        }
+
+        if (list->orderIndex) {
+            *position = OrderIndexRank_ (list->orderIndex, index);
+
+            return NO_LIST_ERRORS;
+        }
+
+        ssize_t rank = 0;
+
+        for (ssize_t node = list->prev [index]; node != 0; node = list->prev [node]) {
+            rank++;
+        }
+
+        *position = rank;
+
+        return NO_LIST_ERRORS;
+    }
+
+    #define EnableOrderIndex(list)              EnableOrderIndex_  (list, CreateCallingFileData)
+    #define DisableOrderIndex(list)             DisableOrderIndex_ (list)
+    #define ListAt(list, position, index)       ListAt_            (list, position, index, CreateCallingFileData)
+    #define ListRankOf(list, index, position)   ListRankOf_        (list, index, position, CreateCallingFileData)
+}
+
+#endif
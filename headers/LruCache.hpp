@@ -0,0 +1,285 @@
+#ifndef LRU_CACHE_HPP_
+#define LRU_CACHE_HPP_
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <sys/types.h>
+#include <utility>
+
+#include <LinkedList.hpp>
+
+namespace LinkedList {
+    const size_t LRU_BUCKETS_PER_ENTRY = 2;  // Keeps linear probing chains short
+    const size_t DEFAULT_LRU_SHARDS    = 16;
+
+    template <typename key_t, typename value_t>
+    struct LruEntry {
+        key_t   key;
+        value_t value;
+
+        template <typename valueArg_t>
+        LruEntry (const key_t &entryKey, valueArg_t &&entryValue) : key (entryKey), value (std::forward <valueArg_t> (entryValue)) {}
+    };
+
+    // Recency list: next [0] is the most recently used entry, prev [0] is the eviction victim.
+    // Everything is allocated by InitLruCache, Get and Put never allocate on their own
+    template <typename key_t, typename value_t, typename hash_t = std::hash <key_t>>
+    struct LruCache {
+        List <LruEntry <key_t, value_t>> entries = {};
+
+        ssize_t *buckets      = NULL; // Node index of the entry or 0 for an empty bucket
+        size_t   bucketsMask  = 0;
+
+        size_t   size         = 0;
+        size_t   capacity     = 0;
+
+        size_t   hits         = 0;
+        size_t   misses       = 0;
+        size_t   evictions    = 0;
+
+        hash_t   hash         = {};
+    };
+
+    template <typename key_t, typename value_t, size_t SHARDS_COUNT = DEFAULT_LRU_SHARDS, typename hash_t = std::hash <key_t>>
+    struct ShardedLruCache {
+        LruCache <key_t, value_t, hash_t> shards [SHARDS_COUNT] = {};
+        std::mutex                        locks  [SHARDS_COUNT] = {};
+    };
+
+    // std::hash is the identity for integers, so the bits are spread before they pick a bucket or a shard
+    inline uint64_t MixHash (uint64_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+
+        return hash;
+    }
+
+    // Bucket holding key or the empty bucket where its probe sequence ends
+    template <typename key_t, typename value_t, typename hash_t>
+    size_t FindLruBucket_ (LruCache <key_t, value_t, hash_t> *cache, const key_t &key) {
+        size_t bucket = (size_t) MixHash (cache->hash (key)) & cache->bucketsMask;
+
+        while (cache->buckets [bucket] != 0 && !(cache->entries.data [cache->buckets [bucket]].key == key)) {
+            bucket = (bucket + 1) & cache->bucketsMask;
+        }
+
+        return bucket;
+    }
+
+    // Backward shift deletion: no tombstones, so probe chains never grow with the number of evictions
+    template <typename key_t, typename value_t, typename hash_t>
+    void EraseLruBucket_ (LruCache <key_t, value_t, hash_t> *cache, size_t bucket) {
+        size_t hole = bucket;
+
+        for (size_t current = (hole + 1) & cache->bucketsMask; cache->buckets [current] != 0; current = (current + 1) & cache->bucketsMask) {
+            size_t home = (size_t) MixHash (cache->hash (cache->entries.data [cache->buckets [current]].key)) & cache->bucketsMask;
+
+            // Entry may fill the hole only if the hole lies on its probe path from home
+            if (((current - home) & cache->bucketsMask) >= ((current - hole) & cache->bucketsMask)) {
+                cache->buckets [hole] = cache->buckets [current];
+                hole = current;
+            }
+        }
+
+        cache->buckets [hole] = 0;
+    }
+
+    template <typename key_t, typename value_t, typename hash_t>
+    ListErrorCode InitLruCache_ (LruCache <key_t, value_t, hash_t> *cache, size_t capacity, CallingFileData creationData) {
+        if (!cache) {
+            return LIST_NULL_POINTER;
+        }
+
+        if (capacity == 0) {
+            return INVALID_CAPACITY;
+        }
+
+        size_t bucketsCount = 1;
+
+        while (bucketsCount < capacity * LRU_BUCKETS_PER_ENTRY) {
+            bucketsCount *= 2;
+        }
+
+        cache->buckets = (ssize_t *) calloc (bucketsCount, sizeof (ssize_t));
+
+        if (!cache->buckets) {
+            return DATA_NULL_POINTER;
+        }
+
+        cache->bucketsMask = bucketsCount - 1;
+        cache->capacity    = capacity;
+        cache->size        = 0;
+
+        return InitList_ (&cache->entries, capacity, creationData);
+    }
+
+    template <typename key_t, typename value_t, typename hash_t>
+    ListErrorCode DestroyLruCache_ (LruCache <key_t, value_t, hash_t> *cache) {
+        if (!cache) {
+            return LIST_NULL_POINTER;
+        }
+
+        free (cache->buckets);
+        cache->buckets = NULL;
+
+        return DestroyList_ (&cache->entries);
+    }
+
+    // *value points into the cache and stays valid until the entry is evicted; NULL on a miss
+    template <typename key_t, typename value_t, typename hash_t>
+    ListErrorCode LruCacheGet_ (LruCache <key_t, value_t, hash_t> *cache, const NonDeduced <key_t> &key, value_t **value, CallingFileData callData) {
+        assert (value);
+
+        size_t  bucket    = FindLruBucket_ (cache, key);
+        ssize_t nodeIndex = cache->buckets [bucket];
+
+        if (nodeIndex == 0) {
+            cache->misses++;
+            *value = NULL;
+
+            return NO_LIST_ERRORS;
+        }
+
+        cache->hits++;
+        *value = &cache->entries.data [nodeIndex].value;
+
+        return MoveAfter_ (&cache->entries, 0, nodeIndex, callData);
+    }
+
+    template <typename key_t, typename value_t, typename hash_t, typename valueArg_t>
+    ListErrorCode LruCachePut_ (LruCache <key_t, value_t, hash_t> *cache, const NonDeduced <key_t> &key, valueArg_t &&value, CallingFileData callData) {
+        size_t  bucket    = FindLruBucket_ (cache, key);
+        ssize_t nodeIndex = cache->buckets [bucket];
+
+        if (nodeIndex != 0) {
+            cache->entries.data [nodeIndex].value = std::forward <valueArg_t> (value);
+
+            return MoveAfter_ (&cache->entries, 0, nodeIndex, callData);
+        }
+
+        if (cache->size == cache->capacity) {
+            ssize_t victimIndex  = cache->entries.prev [0];
+            size_t  victimBucket = FindLruBucket_ (cache, cache->entries.data [victimIndex].key);
+
+            // The bucket is looked up while the key is alive but only erased once the entry is really gone
+            ListErrorCode errorCode = DeleteValue_ (&cache->entries, victimIndex, callData);
+
+            if (errorCode != NO_LIST_ERRORS) {
+                return errorCode;
+            }
+
+            EraseLruBucket_ (cache, victimBucket);
+
+            cache->size--;
+            cache->evictions++;
+
+            // Backward shift may have moved the end of the probe chain
+            bucket = FindLruBucket_ (cache, key);
+        }
+
+        ListErrorCode errorCode = EmplaceAfter_ (&cache->entries, 0, &nodeIndex, callData, key, std::forward <valueArg_t> (value));
+
+        if (errorCode != NO_LIST_ERRORS) {
+            return errorCode;
+        }
+
+        cache->buckets [bucket] = nodeIndex;
+        cache->size++;
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename key_t, typename value_t, size_t SHARDS_COUNT, typename hash_t>
+    LruCache <key_t, value_t, hash_t> *GetLruShard_ (ShardedLruCache <key_t, value_t, SHARDS_COUNT, hash_t> *cache, const key_t &key, std::mutex **lock) {
+        // Upper half of the mixed hash picks the shard, the lower one is left to the buckets
+        size_t shardIndex = (size_t) (MixHash (hash_t {} (key)) >> 32) % SHARDS_COUNT;
+
+        *lock = &cache->locks [shardIndex];
+
+        return &cache->shards [shardIndex];
+    }
+
+    template <typename key_t, typename value_t, size_t SHARDS_COUNT, typename hash_t>
+    ListErrorCode InitShardedLruCache_ (ShardedLruCache <key_t, value_t, SHARDS_COUNT, hash_t> *cache, size_t capacity, CallingFileData creationData) {
+        if (!cache) {
+            return LIST_NULL_POINTER;
+        }
+
+        size_t shardCapacity = (capacity + SHARDS_COUNT - 1) / SHARDS_COUNT;
+
+        for (size_t shardIndex = 0; shardIndex < SHARDS_COUNT; shardIndex++) {
+            ListErrorCode errorCode = InitLruCache_ (&cache->shards [shardIndex], shardCapacity, creationData);
+
+            if (errorCode != NO_LIST_ERRORS) {
+                return errorCode;
+            }
+        }
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename key_t, typename value_t, size_t SHARDS_COUNT, typename hash_t>
+    ListErrorCode DestroyShardedLruCache_ (ShardedLruCache <key_t, value_t, SHARDS_COUNT, hash_t> *cache) {
+        if (!cache) {
+            return LIST_NULL_POINTER;
+        }
+
+        for (size_t shardIndex = 0; shardIndex < SHARDS_COUNT; shardIndex++) {
+            DestroyLruCache_ (&cache->shards [shardIndex]);
+        }
+
+        return NO_LIST_ERRORS;
+    }
+
+    // Value is copied out under the shard lock, since another thread may evict the entry right after it is released
+    template <typename key_t, typename value_t, size_t SHARDS_COUNT, typename hash_t>
+    ListErrorCode ShardedLruCacheGet_ (ShardedLruCache <key_t, value_t, SHARDS_COUNT, hash_t> *cache, const NonDeduced <key_t> &key,
+                                       value_t *value, bool *isFound, CallingFileData callData) {
+        assert (value);
+        assert (isFound);
+
+        std::mutex *lock  = NULL;
+        auto       *shard = GetLruShard_ (cache, key, &lock);
+
+        std::lock_guard <std::mutex> shardLock (*lock);
+
+        value_t      *cachedValue = NULL;
+        ListErrorCode errorCode   = LruCacheGet_ (shard, key, &cachedValue, callData);
+
+        *isFound = cachedValue != NULL;
+
+        if (cachedValue) {
+            *value = *cachedValue;
+        }
+
+        return errorCode;
+    }
+
+    template <typename key_t, typename value_t, size_t SHARDS_COUNT, typename hash_t, typename valueArg_t>
+    ListErrorCode ShardedLruCachePut_ (ShardedLruCache <key_t, value_t, SHARDS_COUNT, hash_t> *cache, const NonDeduced <key_t> &key,
+                                       valueArg_t &&value, CallingFileData callData) {
+        std::mutex *lock  = NULL;
+        auto       *shard = GetLruShard_ (cache, key, &lock);
+
+        std::lock_guard <std::mutex> shardLock (*lock);
+
+        return LruCachePut_ (shard, key, std::forward <valueArg_t> (value), callData);
+    }
+
+    #define InitLruCache(cache, capacity)            InitLruCache_    (cache, capacity, CreateCallingFileData)
+    #define DestroyLruCache(cache)                   DestroyLruCache_ (cache)
+    #define LruCacheGet(cache, key, value)           LruCacheGet_     (cache, key, value, CreateCallingFileData)
+    #define LruCachePut(cache, key, value)           LruCachePut_     (cache, key, value, CreateCallingFileData)
+
+    #define InitShardedLruCache(cache, capacity)             InitShardedLruCache_    (cache, capacity, CreateCallingFileData)
+    #define DestroyShardedLruCache(cache)                    DestroyShardedLruCache_ (cache)
+    #define ShardedLruCacheGet(cache, key, value, isFound)   ShardedLruCacheGet_     (cache, key, value, isFound, CreateCallingFileData)
+    #define ShardedLruCachePut(cache, key, value)            ShardedLruCachePut_     (cache, key, value, CreateCallingFileData)
+}
+
+#endif
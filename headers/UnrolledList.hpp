@@ -0,0 +1,402 @@
+#ifndef UNROLLED_LIST_HPP_
+#define UNROLLED_LIST_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <sys/types.h>
+#include <type_traits>
+
+#include <LinkedList.hpp>
+
+namespace LinkedList {
+    const size_t DEFAULT_UNROLLED_BLOCK_BYTES = 64;
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    constexpr size_t UnrolledBlockCapacity () {
+        return BLOCK_BYTES > sizeof (uint32_t) + sizeof (elem_t) ? (BLOCK_BYTES - sizeof (uint32_t)) / sizeof (elem_t) : 1;
+    }
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    struct alignas (BLOCK_BYTES) UnrolledBlock {
+        static constexpr size_t CAPACITY = UnrolledBlockCapacity <elem_t, BLOCK_BYTES> ();
+
+        elem_t   elements [CAPACITY];
+        uint32_t count;
+    };
+
+    // Blocks are linked the same way as the nodes of List: block 0 is the sentinel, free blocks have blockPrev == -1.
+    // Handles stay attached to their element while blocks split and merge; handle 0 stands for the position before the head.
+    // Every block holds at least CAPACITY / 2 elements unless it is the only one
+    template <typename elem_t, size_t BLOCK_BYTES = DEFAULT_UNROLLED_BLOCK_BYTES>
+    struct UnrolledList {
+        static_assert ((BLOCK_BYTES & (BLOCK_BYTES - 1)) == 0, "Block size must be a power of two");
+        static_assert (std::is_trivially_copyable_v <elem_t>,  "Elements are moved between blocks with memcpy");
+
+        using block_t = UnrolledBlock <elem_t, BLOCK_BYTES>;
+
+        static constexpr ssize_t BLOCK_CAPACITY  = (ssize_t) block_t::CAPACITY;
+        static constexpr ssize_t MIN_BLOCK_COUNT = BLOCK_CAPACITY / 2;
+
+        block_t *blocks         = NULL;
+        ssize_t *blockHandles   = NULL; // BLOCK_CAPACITY handles per block, kept apart so traversal only touches elements
+        ssize_t *blockNext      = NULL;
+        ssize_t *blockPrev      = NULL;
+        ssize_t  blocksCapacity = -1;
+        ssize_t  freeBlock      = -1;
+
+        ssize_t *handleBlock    = NULL; // -1 for a free handle
+        ssize_t *handleSlot     = NULL; // Next free handle for a free one
+        ssize_t  capacity       = -1;
+        ssize_t  freeHandle     = -1;
+
+        ListErrorCode errors;
+        CallingFileData creationData;
+    };
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    void SetUnrolledSlot_ (UnrolledList <elem_t, BLOCK_BYTES> *list, ssize_t block, ssize_t slot, ssize_t handle) {
+        list->blockHandles [block * list->BLOCK_CAPACITY + slot] = handle;
+        list->handleBlock  [handle] = block;
+        list->handleSlot   [handle] = slot;
+    }
+
+    // Moves count elements with their handles; ranges may overlap inside one block
+    template <typename elem_t, size_t BLOCK_BYTES>
+    void MoveUnrolledElements_ (UnrolledList <elem_t, BLOCK_BYTES> *list, ssize_t fromBlock, ssize_t fromSlot,
+                                ssize_t toBlock, ssize_t toSlot, ssize_t count) {
+        if (count <= 0) {
+            return;
+        }
+
+        memmove ((void *) (list->blocks [toBlock].elements + toSlot), list->blocks [fromBlock].elements + fromSlot, (size_t) count * sizeof (elem_t));
+        memmove (list->blockHandles + toBlock * list->BLOCK_CAPACITY + toSlot, list->blockHandles + fromBlock * list->BLOCK_CAPACITY + fromSlot,
+                 (size_t) count * sizeof (ssize_t));
+
+        for (ssize_t slot = toSlot; slot < toSlot + count; slot++) {
+            ssize_t handle = list->blockHandles [toBlock * list->BLOCK_CAPACITY + slot];
+
+            list->handleBlock [handle] = toBlock;
+            list->handleSlot  [handle] = slot;
+        }
+    }
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    ssize_t AllocateUnrolledBlock_ (UnrolledList <elem_t, BLOCK_BYTES> *list, ssize_t afterBlock) {
+        ssize_t block = list->freeBlock;
+
+        if (block == 0) {
+            return 0;
+        }
+
+        list->freeBlock = list->blockNext [block];
+
+        list->blockPrev [list->blockNext [afterBlock]] = block;
+
+        list->blockNext [block]      = list->blockNext [afterBlock];
+        list->blockNext [afterBlock] = block;
+        list->blockPrev [block]      = afterBlock;
+
+        list->blocks [block].count = 0;
+
+        return block;
+    }
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    void FreeUnrolledBlock_ (UnrolledList <elem_t, BLOCK_BYTES> *list, ssize_t block) {
+        list->blockPrev [list->blockNext [block]] = list->blockPrev [block];
+        list->blockNext [list->blockPrev [block]] = list->blockNext [block];
+
+        list->blockNext [block] = list->freeBlock;
+        list->blockPrev [block] = -1;
+        list->freeBlock         = block;
+    }
+
+    // Restores the fill invariant after a deletion by borrowing one element from a neighbour or merging with it
+    template <typename elem_t, size_t BLOCK_BYTES>
+    void RebalanceUnrolledBlock_ (UnrolledList <elem_t, BLOCK_BYTES> *list, ssize_t block) {
+        ssize_t count = list->blocks [block].count;
+
+        if (count == 0) {
+            FreeUnrolledBlock_ (list, block);
+            return;
+        }
+
+        ssize_t nextBlock = list->blockNext [block];
+        ssize_t prevBlock = list->blockPrev [block];
+
+        if (count >= list->MIN_BLOCK_COUNT || (nextBlock == 0 && prevBlock == 0)) {
+            return;
+        }
+
+        ssize_t neighbour      = nextBlock != 0 ? nextBlock : prevBlock;
+        ssize_t neighbourCount = list->blocks [neighbour].count;
+
+        if (neighbourCount > list->MIN_BLOCK_COUNT) {
+            if (neighbour == nextBlock) {
+                MoveUnrolledElements_ (list, nextBlock, 0, block, count, 1);
+                MoveUnrolledElements_ (list, nextBlock, 1, nextBlock, 0, neighbourCount - 1);
+            } else {
+                MoveUnrolledElements_ (list, block, 0, block, 1, count);
+                MoveUnrolledElements_ (list, prevBlock, neighbourCount - 1, block, 0, 1);
+            }
+
+            list->blocks [block].count++;
+            list->blocks [neighbour].count--;
+
+            return;
+        }
+
+        ssize_t leftBlock  = neighbour == nextBlock ? block     : prevBlock;
+        ssize_t rightBlock = neighbour == nextBlock ? nextBlock : block;
+
+        MoveUnrolledElements_ (list, rightBlock, 0, leftBlock, list->blocks [leftBlock].count, list->blocks [rightBlock].count);
+
+        list->blocks [leftBlock].count += list->blocks [rightBlock].count;
+        list->blocks [rightBlock].count = 0;
+
+        FreeUnrolledBlock_ (list, rightBlock);
+    }
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    ListErrorCode InitList_ (UnrolledList <elem_t, BLOCK_BYTES> *list, size_t capacity, CallingFileData creationData) {
+        if (!list) {
+            return LIST_NULL_POINTER;
+        }
+
+        using block_t = typename UnrolledList <elem_t, BLOCK_BYTES>::block_t;
+
+        list->capacity       = (ssize_t) capacity + 1;
+        list->blocksCapacity = (ssize_t) capacity / std::max (list->MIN_BLOCK_COUNT, (ssize_t) 1) + 2;
+
+        list->blocks       = AllocateElements_ <block_t> ((size_t) list->blocksCapacity);
+        list->blockHandles = (ssize_t *) calloc ((size_t) (list->blocksCapacity * list->BLOCK_CAPACITY), sizeof (ssize_t));
+        list->blockNext    = (ssize_t *) calloc ((size_t) list->blocksCapacity, sizeof (ssize_t));
+        list->blockPrev    = (ssize_t *) calloc ((size_t) list->blocksCapacity, sizeof (ssize_t));
+        list->handleBlock  = (ssize_t *) calloc ((size_t) list->capacity,       sizeof (ssize_t));
+        list->handleSlot   = (ssize_t *) calloc ((size_t) list->capacity,       sizeof (ssize_t));
+
+        #define CheckForNull(expression, error) if (!(expression)) {return error;}
+
+        CheckForNull (list->blocks,       DATA_NULL_POINTER);
+        CheckForNull (list->blockHandles, DATA_NULL_POINTER);
+        CheckForNull (list->blockNext,    NEXT_NULL_POINTER);
+        CheckForNull (list->blockPrev,    PREV_NULL_POINTER);
+        CheckForNull (list->handleBlock,  DATA_NULL_POINTER);
+        CheckForNull (list->handleSlot,   DATA_NULL_POINTER);
+
+        #undef CheckForNull
+
+        list->freeBlock  = 1;
+        list->freeHandle = 1;
+
+        for (ssize_t blockIndex = list->freeBlock; blockIndex < list->blocksCapacity; blockIndex++) {
+            list->blockNext [blockIndex] = (blockIndex + 1) % list->blocksCapacity;
+            list->blockPrev [blockIndex] = -1;
+        }
+
+        for (ssize_t handle = list->freeHandle; handle < list->capacity; handle++) {
+            list->handleBlock [handle] = -1;
+            list->handleSlot  [handle] = (handle + 1) % list->capacity;
+        }
+
+        list->creationData = creationData;
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    ListErrorCode DestroyList_ (UnrolledList <elem_t, BLOCK_BYTES> *list) {
+        if (!list) {
+            return LIST_NULL_POINTER;
+        }
+
+        free (list->blocks);
+        free (list->blockHandles);
+        free (list->blockNext);
+        free (list->blockPrev);
+        free (list->handleBlock);
+        free (list->handleSlot);
+
+        *list = {};
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    ListErrorCode InsertAfter_ (UnrolledList <elem_t, BLOCK_BYTES> *list, ssize_t insertHandle, ssize_t *newHandle,
+                                const NonDeduced <elem_t> &element, CallingFileData callData) {
+        assert (newHandle);
+
+        if (insertHandle < 0 || insertHandle >= list->capacity) {
+            return WRONG_INDEX;
+        }
+
+        if (insertHandle != 0 && list->handleBlock [insertHandle] <= 0) {
+            return WRONG_INDEX;
+        }
+
+        if (list->freeHandle == 0) {
+            return INVALID_CAPACITY;
+        }
+
+        ssize_t block = insertHandle ? list->handleBlock [insertHandle]    : list->blockNext [0];
+        ssize_t slot  = insertHandle ? list->handleSlot  [insertHandle] + 1 : 0;
+
+        if (block == 0) {
+            block = AllocateUnrolledBlock_ (list, 0);
+        } else if (list->blocks [block].count == list->BLOCK_CAPACITY) {
+            ssize_t nextBlock = list->blockNext [block];
+
+            if (list->BLOCK_CAPACITY == 1) {
+                block = AllocateUnrolledBlock_ (list, slot == 0 ? list->blockPrev [block] : block);
+                slot  = 0;
+            } else if (slot == list->BLOCK_CAPACITY && nextBlock != 0 && list->blocks [nextBlock].count < list->BLOCK_CAPACITY) {
+                block = nextBlock;
+                slot  = 0;
+            } else {
+                ssize_t splitBlock = AllocateUnrolledBlock_ (list, block);
+                ssize_t leftCount  = list->MIN_BLOCK_COUNT;
+
+                if (splitBlock == 0) {
+                    return INVALID_CAPACITY;
+                }
+
+                MoveUnrolledElements_ (list, block, leftCount, splitBlock, 0, list->BLOCK_CAPACITY - leftCount);
+
+                list->blocks [splitBlock].count = (uint32_t) (list->BLOCK_CAPACITY - leftCount);
+                list->blocks [block].count      = (uint32_t) leftCount;
+
+                if (slot > leftCount) {
+                    block = splitBlock;
+                    slot -= leftCount;
+                }
+            }
+        }
+
+        if (block == 0) {
+            return INVALID_CAPACITY;
+        }
+
+        MoveUnrolledElements_ (list, block, slot, block, slot + 1, (ssize_t) list->blocks [block].count - slot);
+
+        ssize_t handle = list->freeHandle;
+        list->freeHandle = list->handleSlot [handle];
+
+        list->blocks [block].elements [slot] = element;
+        list->blocks [block].count++;
+
+        SetUnrolledSlot_ (list, block, slot, handle);
+
+        *newHandle = handle;
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    ListErrorCode DeleteValue_ (UnrolledList <elem_t, BLOCK_BYTES> *list, ssize_t deleteHandle, CallingFileData callData) {
+
+        if (deleteHandle <= 0 || deleteHandle >= list->capacity) {
+            return WRONG_INDEX;
+        }
+
+        ssize_t block = list->handleBlock [deleteHandle];
+        ssize_t slot  = list->handleSlot  [deleteHandle];
+
+        if (block <= 0) {
+            return WRONG_INDEX;
+        }
+
+        MoveUnrolledElements_ (list, block, slot + 1, block, slot, (ssize_t) list->blocks [block].count - slot - 1);
+
+        list->blocks [block].count--;
+
+        list->handleBlock [deleteHandle] = -1;
+        list->handleSlot  [deleteHandle] = list->freeHandle;
+        list->freeHandle                 = deleteHandle;
+
+        RebalanceUnrolledBlock_ (list, block);
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    elem_t &UnrolledListValue (UnrolledList <elem_t, BLOCK_BYTES> *list, ssize_t handle) {
+        return list->blocks [list->handleBlock [handle]].elements [list->handleSlot [handle]];
+    }
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    ListErrorCode FindValueInListSlowImplementation_ (UnrolledList <elem_t, BLOCK_BYTES> *list, const NonDeduced <elem_t> &value,
+                                                      ssize_t *handle, CallingFileData callData) {
+
+        for (ssize_t block = list->blockNext [0]; block != 0; block = list->blockNext [block]) {
+            const elem_t *elements = list->blocks [block].elements;
+            ssize_t       count    = list->blocks [block].count;
+
+            for (ssize_t slot = 0; slot < count; slot++) {
+                bool isEqual = false;
+
+                if constexpr (std::is_floating_point_v <elem_t>) {
+                    isEqual = std::abs (elements [slot] - value) < EPS;
+                } else {
+                    isEqual = elements [slot] == value;
+                }
+
+                if (isEqual) {
+                    *handle = list->blockHandles [block * list->BLOCK_CAPACITY + slot];
+                    return NO_LIST_ERRORS;
+                }
+            }
+        }
+
+        *handle = -1;
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    struct UnrolledListIterator {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = elem_t;
+        using difference_type   = ptrdiff_t;
+        using pointer           = elem_t *;
+        using reference         = elem_t &;
+
+        UnrolledList <elem_t, BLOCK_BYTES> *list  = NULL;
+        ssize_t                             block = 0;
+        ssize_t                             slot  = 0;
+
+        ssize_t   Handle     () const {return list->blockHandles [block * list->BLOCK_CAPACITY + slot];}
+        reference operator*  () const {return list->blocks [block].elements [slot];}
+        pointer   operator-> () const {return list->blocks [block].elements + slot;}
+
+        UnrolledListIterator &operator++ () {
+            if (++slot == (ssize_t) list->blocks [block].count) {
+                block = list->blockNext [block];
+                slot  = 0;
+            }
+
+            return *this;
+        }
+
+        UnrolledListIterator operator++ (int) {
+            UnrolledListIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator== (const UnrolledListIterator &other) const {return block == other.block && slot == other.slot;}
+        bool operator!= (const UnrolledListIterator &other) const {return !(*this == other);}
+    };
+
+    template <typename elem_t, size_t BLOCK_BYTES>
+    UnrolledListIterator <elem_t, BLOCK_BYTES> begin (UnrolledList <elem_t, BLOCK_BYTES> &list) {return {&list, list.blockNext [0], 0};}
+    template <typename elem_t, size_t BLOCK_BYTES>
+    UnrolledListIterator <elem_t, BLOCK_BYTES> end   (UnrolledList <elem_t, BLOCK_BYTES> &list) {return {&list, 0, 0};}
+}
+
+#endif
@@ -0,0 +1,537 @@
+#ifndef VERSIONED_LIST_HPP_
+#define VERSIONED_LIST_HPP_
+
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/types.h>
+#include <type_traits>
+
+#include <LinkedList.hpp>
+
+namespace LinkedList {
+    const size_t DEFAULT_COW_CHUNK_SIZE = 1024;
+
+    template <typename item_t, size_t CHUNK_SIZE>
+    struct CowChunk {
+        std::atomic <size_t> references;
+        item_t               items [CHUNK_SIZE];
+    };
+
+    // Table of chunk pointers, shared between forks as a whole until one of them writes
+    template <typename item_t, size_t CHUNK_SIZE>
+    struct CowArray {
+        std::atomic <size_t>              references;
+        size_t                            chunksCount;
+        CowChunk <item_t, CHUNK_SIZE>   **chunks;
+    };
+
+    // Same layout and semantics as List <elem_t>, but data/next/prev are split into reference counted chunks:
+    // ForkList only bumps three counters, and a writer copies the table and the chunks it touches on first write
+    template <typename elem_t, size_t CHUNK_SIZE = DEFAULT_COW_CHUNK_SIZE>
+    struct VersionedList {
+        static_assert (std::is_trivially_copyable_v <elem_t>, "Chunks are copied with memcpy");
+
+        CowArray <elem_t,  CHUNK_SIZE> *data = NULL;
+        CowArray <ssize_t, CHUNK_SIZE> *next = NULL;
+        CowArray <ssize_t, CHUNK_SIZE> *prev = NULL;
+
+        ssize_t capacity    = -1;
+
+        ssize_t freeElem    = -1;
+
+        ListErrorCode errors;
+        CallingFileData creationData;
+    };
+
+    template <typename item_t, size_t CHUNK_SIZE>
+    CowChunk <item_t, CHUNK_SIZE> *CreateCowChunk_ (const CowChunk <item_t, CHUNK_SIZE> *source) {
+        CowChunk <item_t, CHUNK_SIZE> *chunk = (CowChunk <item_t, CHUNK_SIZE> *) calloc (1, sizeof (CowChunk <item_t, CHUNK_SIZE>));
+
+        if (!chunk) {
+            return NULL;
+        }
+
+        new (&chunk->references) std::atomic <size_t> (1);
+
+        if (source) {
+            memcpy ((void *) chunk->items, source->items, sizeof (chunk->items));
+        }
+
+        return chunk;
+    }
+
+    template <typename item_t, size_t CHUNK_SIZE>
+    void ReleaseCowChunk_ (CowChunk <item_t, CHUNK_SIZE> *chunk) {
+        if (chunk && chunk->references.fetch_sub (1, std::memory_order_acq_rel) == 1) {
+            free (chunk);
+        }
+    }
+
+    template <typename item_t, size_t CHUNK_SIZE>
+    CowArray <item_t, CHUNK_SIZE> *CreateCowArray_ (size_t chunksCount) {
+        CowArray <item_t, CHUNK_SIZE> *array = (CowArray <item_t, CHUNK_SIZE> *) calloc (1, sizeof (CowArray <item_t, CHUNK_SIZE>));
+
+        if (!array) {
+            return NULL;
+        }
+
+        new (&array->references) std::atomic <size_t> (1);
+
+        array->chunksCount = chunksCount;
+        array->chunks      = (CowChunk <item_t, CHUNK_SIZE> **) calloc (chunksCount, sizeof (CowChunk <item_t, CHUNK_SIZE> *));
+
+        if (!array->chunks) {
+            free (array);
+            return NULL;
+        }
+
+        return array;
+    }
+
+    template <typename item_t, size_t CHUNK_SIZE>
+    void ReleaseCowArray_ (CowArray <item_t, CHUNK_SIZE> *array) {
+        if (!array || array->references.fetch_sub (1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        for (size_t chunkIndex = 0; chunkIndex < array->chunksCount; chunkIndex++) {
+            ReleaseCowChunk_ (array->chunks [chunkIndex]);
+        }
+
+        free (array->chunks);
+        free (array);
+    }
+
+    template <typename item_t, size_t CHUNK_SIZE>
+    const item_t &ReadCowItem_ (const CowArray <item_t, CHUNK_SIZE> *array, ssize_t index) {
+        return array->chunks [(size_t) index / CHUNK_SIZE]->items [(size_t) index % CHUNK_SIZE];
+    }
+
+    // Makes the table and the chunk holding index private to this version; NULL if a copy could not be allocated
+    template <typename item_t, size_t CHUNK_SIZE>
+    item_t *WriteCowItem_ (CowArray <item_t, CHUNK_SIZE> **array, ssize_t index) {
+        CowArray <item_t, CHUNK_SIZE> *table = *array;
+
+        if (table->references.load (std::memory_order_acquire) > 1) {
+            CowArray <item_t, CHUNK_SIZE> *tableCopy = CreateCowArray_ <item_t, CHUNK_SIZE> (table->chunksCount);
+
+            if (!tableCopy) {
+                return NULL;
+            }
+
+            for (size_t chunkIndex = 0; chunkIndex < table->chunksCount; chunkIndex++) {
+                tableCopy->chunks [chunkIndex] = table->chunks [chunkIndex];
+                tableCopy->chunks [chunkIndex]->references.fetch_add (1, std::memory_order_relaxed);
+            }
+
+            ReleaseCowArray_ (table);
+
+            *array = table = tableCopy;
+        }
+
+        size_t chunkIndex = (size_t) index / CHUNK_SIZE;
+
+        CowChunk <item_t, CHUNK_SIZE> *chunk = table->chunks [chunkIndex];
+
+        if (chunk->references.load (std::memory_order_acquire) > 1) {
+            CowChunk <item_t, CHUNK_SIZE> *chunkCopy = CreateCowChunk_ (chunk);
+
+            if (!chunkCopy) {
+                return NULL;
+            }
+
+            ReleaseCowChunk_ (chunk);
+
+            table->chunks [chunkIndex] = chunk = chunkCopy;
+        }
+
+        return chunk->items + (size_t) index % CHUNK_SIZE;
+    }
+
+    template <typename elem_t, size_t CHUNK_SIZE>
+    const elem_t &VersionedListValue (const VersionedList <elem_t, CHUNK_SIZE> *list, ssize_t index) {
+        return ReadCowItem_ (list->data, index);
+    }
+
+    template <typename elem_t, size_t CHUNK_SIZE>
+    ssize_t VersionedListNext (const VersionedList <elem_t, CHUNK_SIZE> *list, ssize_t index) {
+        return ReadCowItem_ (list->next, index);
+    }
+
+    template <typename elem_t, size_t CHUNK_SIZE>
+    ssize_t VersionedListPrev (const VersionedList <elem_t, CHUNK_SIZE> *list, ssize_t index) {
+        return ReadCowItem_ (list->prev, index);
+    }
+
+    template <typename item_t, size_t CHUNK_SIZE>
+    bool IsCowArrayValid_ (const CowArray <item_t, CHUNK_SIZE> *array, ssize_t capacity, ListErrorCode *referenceErrors) {
+        if (!array || !array->chunks || array->chunksCount != ((size_t) capacity + CHUNK_SIZE - 1) / CHUNK_SIZE) {
+            return false;
+        }
+
+        if (array->references.load (std::memory_order_acquire) == 0) {
+            *referenceErrors = INVALID_REFERENCES;
+        }
+
+        for (size_t chunkIndex = 0; chunkIndex < array->chunksCount; chunkIndex++) {
+            if (!array->chunks [chunkIndex]) {
+                return false;
+            }
+
+            if (array->chunks [chunkIndex]->references.load (std::memory_order_acquire) == 0) {
+                *referenceErrors = INVALID_REFERENCES;
+            }
+        }
+
+        return true;
+    }
+
+    // Checks the chunk tables and their reference counts, then walks both chains through them:
+    // every live node must be linked back by its successor, every free one must have prev == -1
+    template <typename elem_t, size_t CHUNK_SIZE>
+    ListErrorCode VerifyList_ (VersionedList <elem_t, CHUNK_SIZE> *list) {
+
+        #define WriteErrors(list, errorCodes)  (list)->errors = (ListErrorCode) ((list)->errors | (errorCodes))
+        #define ErrorCheck(condition, errorCodes)   \
+            do {                                    \
+                if (!(condition)) {                 \
+                    WriteErrors (list, errorCodes); \
+                }                                   \
+            } while (0)
+
+        if (!list) {
+            return LIST_NULL_POINTER;
+        }
+
+        ListErrorCode referenceErrors = NO_LIST_ERRORS;
+
+        ErrorCheck (list->capacity > 0, INVALID_CAPACITY);
+
+        // Chains can only be walked through complete tables
+        if (list->capacity <= 0) {
+            return list->errors;
+        }
+
+        ErrorCheck (IsCowArrayValid_ (list->data, list->capacity, &referenceErrors), DATA_NULL_POINTER);
+        ErrorCheck (IsCowArrayValid_ (list->prev, list->capacity, &referenceErrors), PREV_NULL_POINTER);
+        ErrorCheck (IsCowArrayValid_ (list->next, list->capacity, &referenceErrors), NEXT_NULL_POINTER);
+
+        WriteErrors (list, referenceErrors);
+
+        if (list->errors & (INVALID_CAPACITY | DATA_NULL_POINTER | PREV_NULL_POINTER | NEXT_NULL_POINTER)) {
+            return list->errors;
+        }
+
+        ssize_t head = VersionedListNext (list, 0);
+        ssize_t tail = VersionedListPrev (list, 0);
+
+        ErrorCheck (head >= 0 && head < list->capacity,                     INVALID_HEAD);
+        ErrorCheck (tail >= 0 && tail < list->capacity,                     INVALID_TAIL);
+        ErrorCheck (list->freeElem >= 0 && list->freeElem < list->capacity, FREE_LIST_ERROR);
+
+        if (list->errors & (INVALID_HEAD | INVALID_TAIL | FREE_LIST_ERROR)) {
+            return list->errors;
+        }
+
+        // A consistent chain visits every slot at most once, so capacity hops bound a walk through a cycle
+        ssize_t previousNode = 0;
+        ssize_t node         = head;
+
+        for (ssize_t hops = 0; node != 0 && hops < list->capacity; hops++) {
+            if (node < 0 || node >= list->capacity || VersionedListPrev (list, node) != previousNode) {
+                WriteErrors (list, INVALID_LINKS);
+                break;
+            }
+
+            previousNode = node;
+            node         = VersionedListNext (list, node);
+        }
+
+        ErrorCheck (node == 0 && previousNode == tail, INVALID_LINKS);
+
+        ssize_t freeIndex = list->freeElem;
+
+        for (ssize_t hops = 0; freeIndex > 0 && hops < list->capacity; hops++) {
+            if (freeIndex >= list->capacity || VersionedListPrev (list, freeIndex) != -1) {
+                WriteErrors (list, FREE_LIST_ERROR);
+                break;
+            }
+
+            freeIndex = VersionedListNext (list, freeIndex);
+        }
+
+        ErrorCheck (freeIndex == 0, FREE_LIST_ERROR);
+
+        #undef WriteErrors
+        #undef ErrorCheck
+
+        return list->errors;
+    }
+
+    // Same text format as the List <elem_t> dump, with the reference counts of the tables and chunks first
+    template <typename elem_t, size_t CHUNK_SIZE>
+    ListErrorCode DumpList_ (VersionedList <elem_t, CHUNK_SIZE> *list, char *logFolder, CallingFileData callData) {
+        if (!list) {
+            return LIST_NULL_POINTER;
+        }
+
+        char dumpFilename [FILENAME_MAX] = "";
+        snprintf (dumpFilename, FILENAME_MAX, "%s/list_dump.txt", logFolder);
+
+        FILE *dumpFile = fopen (dumpFilename, "a");
+
+        if (!dumpFile) {
+            return LOG_FILE_ERROR;
+        }
+
+        CallingFileData *creationData = &list->creationData;
+
+        fprintf (dumpFile, "Versioned list dump called from %s:%d (%s)\n", callData.file ? callData.file : "(null)", callData.line,
+                 callData.function ? callData.function : "(null)");
+        fprintf (dumpFile, "Created in %s:%d (%s)\n", creationData->file ? creationData->file : "(null)", creationData->line,
+                 creationData->function ? creationData->function : "(null)");
+        fprintf (dumpFile, "capacity = %zd, free = %zd, errors = %d\n", list->capacity, list->freeElem, (int) list->errors);
+
+        auto DumpReferences = [dumpFile] (const char *arrayName, const auto *array) {
+            if (!array) {
+                fprintf (dumpFile, "%s: no table\n", arrayName);
+                return;
+            }
+
+            fprintf (dumpFile, "%s: table references = %zu, chunk references =", arrayName, array->references.load ());
+
+            for (size_t chunkIndex = 0; chunkIndex < array->chunksCount && array->chunks; chunkIndex++) {
+                if (array->chunks [chunkIndex]) {
+                    fprintf (dumpFile, " %zu", array->chunks [chunkIndex]->references.load ());
+                } else {
+                    fprintf (dumpFile, " NULL");
+                }
+            }
+
+            fputc ('\n', dumpFile);
+        };
+
+        DumpReferences ("data", list->data);
+        DumpReferences ("next", list->next);
+        DumpReferences ("prev", list->prev);
+
+        // Slots are only read when the tables passed verification
+        if (!(list->errors & (INVALID_CAPACITY | DATA_NULL_POINTER | PREV_NULL_POINTER | NEXT_NULL_POINTER))) {
+            ssize_t dumpedNodes = list->capacity < MAX_TEXT_DUMP_NODES ? list->capacity : MAX_TEXT_DUMP_NODES;
+
+            for (ssize_t nodeIndex = 0; nodeIndex < dumpedNodes; nodeIndex++) {
+                fprintf (dumpFile, "%8zd: next = %8zd, prev = %8zd\n", nodeIndex, VersionedListNext (list, nodeIndex),
+                         VersionedListPrev (list, nodeIndex));
+            }
+
+            if (dumpedNodes < list->capacity) {
+                fprintf (dumpFile, "... %zd more slots\n", list->capacity - dumpedNodes);
+            }
+        }
+
+        fputc ('\n', dumpFile);
+        fclose (dumpFile);
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, size_t CHUNK_SIZE>
+    ListErrorCode InitList_ (VersionedList <elem_t, CHUNK_SIZE> *list, size_t capacity, CallingFileData creationData) {
+        if (!list) {
+            return LIST_NULL_POINTER;
+        }
+
+        list->capacity = (ssize_t) capacity + 1;
+
+        size_t chunksCount = ((size_t) list->capacity + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+        list->next = CreateCowArray_ <ssize_t, CHUNK_SIZE> (chunksCount);
+        list->prev = CreateCowArray_ <ssize_t, CHUNK_SIZE> (chunksCount);
+        list->data = CreateCowArray_ <elem_t,  CHUNK_SIZE> (chunksCount);
+
+        #define CheckForNull(expression, error) if (!(expression)) {return error;}
+
+        CheckForNull (list->prev, PREV_NULL_POINTER);
+        CheckForNull (list->next, NEXT_NULL_POINTER);
+        CheckForNull (list->data, DATA_NULL_POINTER);
+
+        for (size_t chunkIndex = 0; chunkIndex < chunksCount; chunkIndex++) {
+            list->prev->chunks [chunkIndex] = CreateCowChunk_ <ssize_t, CHUNK_SIZE> (NULL);
+            list->next->chunks [chunkIndex] = CreateCowChunk_ <ssize_t, CHUNK_SIZE> (NULL);
+            list->data->chunks [chunkIndex] = CreateCowChunk_ <elem_t,  CHUNK_SIZE> (NULL);
+
+            CheckForNull (list->prev->chunks [chunkIndex], PREV_NULL_POINTER);
+            CheckForNull (list->next->chunks [chunkIndex], NEXT_NULL_POINTER);
+            CheckForNull (list->data->chunks [chunkIndex], DATA_NULL_POINTER);
+        }
+
+        #undef CheckForNull
+
+        list->freeElem = 1;
+
+        for (ssize_t listIndex = list->freeElem; listIndex < list->capacity; listIndex++) {
+            *WriteCowItem_ (&list->next, listIndex) = (listIndex + 1) % list->capacity;
+            *WriteCowItem_ (&list->prev, listIndex) = -1;
+        }
+
+        list->creationData = creationData;
+
+        Verification (list, creationData);
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, size_t CHUNK_SIZE>
+    ListErrorCode DestroyList_ (VersionedList <elem_t, CHUNK_SIZE> *list) {
+        if (!list) {
+            return LIST_NULL_POINTER;
+        }
+
+        ReleaseCowArray_ (list->data);
+        ReleaseCowArray_ (list->prev);
+        ReleaseCowArray_ (list->next);
+
+        list->data = NULL;
+        list->prev = NULL;
+        list->next = NULL;
+
+        return NO_LIST_ERRORS;
+    }
+
+    // fork must not hold a list; it shares everything with source until one of them is modified
+    template <typename elem_t, size_t CHUNK_SIZE>
+    ListErrorCode ForkList_ (VersionedList <elem_t, CHUNK_SIZE> *source, VersionedList <elem_t, CHUNK_SIZE> *fork, CallingFileData callData) {
+        if (!source || !fork) {
+            return LIST_NULL_POINTER;
+        }
+
+        Verification (source, callData);
+
+        if (!source->data || !source->next || !source->prev) {
+            return DATA_NULL_POINTER;
+        }
+
+        source->data->references.fetch_add (1, std::memory_order_relaxed);
+        source->next->references.fetch_add (1, std::memory_order_relaxed);
+        source->prev->references.fetch_add (1, std::memory_order_relaxed);
+
+        *fork = *source;
+
+        fork->creationData = callData;
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, size_t CHUNK_SIZE>
+    ListErrorCode InsertAfter_ (VersionedList <elem_t, CHUNK_SIZE> *list, ssize_t insertIndex, ssize_t *newIndex,
+                                const NonDeduced <elem_t> &element, CallingFileData callData) {
+        assert (newIndex);
+
+        Verification (list, callData);
+
+        if (insertIndex < 0 || insertIndex >= list->capacity) {
+            return WRONG_INDEX;
+        }
+
+        if (ReadCowItem_ (list->prev, insertIndex) == -1) {
+            return WRONG_INDEX;
+        }
+
+        if (list->freeElem == 0) {
+            return INVALID_CAPACITY;
+        }
+
+        ssize_t insertedIndex = list->freeElem;
+        ssize_t nextIndex     = ReadCowItem_ (list->next, insertIndex);
+
+        ssize_t *insertedNext = WriteCowItem_ (&list->next, insertedIndex);
+        ssize_t *insertedPrev = WriteCowItem_ (&list->prev, insertedIndex);
+        elem_t  *insertedData = WriteCowItem_ (&list->data, insertedIndex);
+        ssize_t *nextPrev     = WriteCowItem_ (&list->prev, nextIndex);
+        ssize_t *insertNext   = WriteCowItem_ (&list->next, insertIndex);
+
+        // All copies are made before the first write, so a failed allocation leaves the list consistent
+        if (!insertedNext || !insertedPrev || !insertedData || !nextPrev || !insertNext) {
+            return DATA_NULL_POINTER;
+        }
+
+        list->freeElem = *insertedNext;
+
+        *nextPrev     = insertedIndex;
+        *insertedNext = nextIndex;
+        *insertNext   = insertedIndex;
+        *insertedPrev = insertIndex;
+        *insertedData = element;
+
+        *newIndex = insertedIndex;
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, size_t CHUNK_SIZE>
+    ListErrorCode DeleteValue_ (VersionedList <elem_t, CHUNK_SIZE> *list, ssize_t deleteIndex, CallingFileData callData) {
+        Verification (list, callData);
+
+        if (deleteIndex <= 0 || deleteIndex >= list->capacity) {
+            return WRONG_INDEX;
+        }
+
+        ssize_t prevIndex = ReadCowItem_ (list->prev, deleteIndex);
+        ssize_t nextIndex = ReadCowItem_ (list->next, deleteIndex);
+
+        if (prevIndex == -1) {
+            return WRONG_INDEX;
+        }
+
+        ssize_t *nextPrev    = WriteCowItem_ (&list->prev, nextIndex);
+        ssize_t *prevNext    = WriteCowItem_ (&list->next, prevIndex);
+        ssize_t *deletedNext = WriteCowItem_ (&list->next, deleteIndex);
+        ssize_t *deletedPrev = WriteCowItem_ (&list->prev, deleteIndex);
+
+        if (!nextPrev || !prevNext || !deletedNext || !deletedPrev) {
+            return DATA_NULL_POINTER;
+        }
+
+        *nextPrev    = prevIndex;
+        *prevNext    = nextIndex;
+        *deletedNext = list->freeElem;
+        *deletedPrev = -1;
+
+        list->freeElem = deleteIndex;
+
+        return NO_LIST_ERRORS;
+    }
+
+    template <typename elem_t, size_t CHUNK_SIZE>
+    ListErrorCode FindValueInListSlowImplementation_ (VersionedList <elem_t, CHUNK_SIZE> *list, const NonDeduced <elem_t> &value,
+                                                      ssize_t *index, CallingFileData callData) {
+        Verification (list, callData);
+
+        for (ssize_t elementIndex = VersionedListNext (list, 0); elementIndex != 0; elementIndex = VersionedListNext (list, elementIndex)) {
+            bool isEqual = false;
+
+            if constexpr (std::is_floating_point_v <elem_t>) {
+                isEqual = std::abs (VersionedListValue (list, elementIndex) - value) < EPS;
+            } else {
+                isEqual = VersionedListValue (list, elementIndex) == value;
+            }
+
+            if (isEqual) {
+                *index = elementIndex;
+                return NO_LIST_ERRORS;
+            }
+        }
+
+        *index = -1;
+        return NO_LIST_ERRORS;
+    }
+
+    #define ForkList(source, fork) ForkList_ (source, fork, CreateCallingFileData)
+}
+
+#endif
@@ -1,114 +1,570 @@
 #include <bits/types/FILE.h>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <mutex>
 #include <stdlib.h>
 #include <stdio.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <thread>
 #include <time.h>
 #include <unistd.h>
 
 #include "GraphVizDump.h"
-#include "Buffer.h"
 #include "CustomAssert.h"
 #include "LinkedList.h"
 #include "Logger.h"
 
 namespace LinkedList {
 
-    static ListErrorCode DumpNode            (List *list, ssize_t nodeIndex, Buffer <char> *graphvizBuffer);
-    static ListErrorCode DumpNodeConnections (List *list, ssize_t nodeIndex, Buffer <char> *graphvizBuffer);
-    static ListErrorCode DumpConnection      (List *list, Buffer <char> *graphvizBuffer, const char *from, const char *to, const char *color);
-    static ListErrorCode WriteDumpHeader     (List *list, Buffer <char> *graphvizBuffer, CallingFileData *callData);
-    static ListErrorCode WriteCallData       (List *list, CallingFileData *callData, Buffer <char> *graphvizBuffer);
-    static char         *GetLogFilename      (char *logFolder);
-    static ListErrorCode WriteToHtml         (char *dotFilename);
-
-    #define WriteWithErrorCheck(buffer, data)                                                          \
-                do  {                                                                               \
-                    if (WriteStringToBuffer (buffer, data) != BufferErrorCode::NO_BUFFER_ERRORS) {  \
-                        DestroyBuffer (buffer);                                                     \
-                        RETURN GRAPHVIZ_BUFFER_ERROR;                                               \
-                    }                                                                               \
-                } while (0)
-
-    #define WriteIndexToDump(dumpBuffer, indexBuffer, index)            \
-                snprintf (indexBuffer, MAX_INDEX_LENGTH, "%ld", index); \
-                WriteWithErrorCheck (dumpBuffer, indexBuffer)
+    // Everything that runs on the dump workers stays away from PushLog: the logger stack belongs to the calling thread
+
+    struct DumpRequest {
+        DumpParameters  parameters                = {};
+        List            snapshot                  = {};   // Arrays hold nodesCount entries
+        ssize_t        *nodeIndices               = NULL; // List index of every snapshot entry, NULL when the whole list was copied
+        size_t          nodesCount                = 0;
+        ssize_t         head                      = 0;
+        ssize_t         tail                      = 0;
+        const List     *source                    = NULL;
+        CallingFileData callData                  = {};
+        char            logFolder [FILENAME_MAX]  = "";
+        char           *dumpFilename              = NULL;
+        size_t          sequenceNumber            = 0;     // Place of the entry in dump.html
+        bool            isWritten                 = false;
+    };
+
+    struct DumpQueue {
+        std::mutex                 queueMutex             = {};
+        std::mutex                 htmlMutex              = {};
+        std::condition_variable    hasRequests            = {};
+        std::condition_variable    isIdle                 = {};
+        std::deque <DumpRequest *> requests               = {};
+        std::thread                workers [DUMP_WORKERS_COUNT] = {};
+        std::once_flag             workersStarted         = {};
+        size_t                     busyWorkers            = 0;
+        size_t                     droppedDumps           = 0; // Both are reset once FlushDumps reports them
+        size_t                     mergedDumps            = 0;
+        size_t                     nextSequenceNumber     = 0;
+        bool                       stopWorkers            = false;
+
+        // Workers finish out of order, so an entry waits here until every earlier one is in dump.html (htmlMutex)
+        std::map <size_t, DumpRequest *> finishedDumps    = {};
+        size_t                     nextHtmlSequenceNumber = 0;
+
+        ~DumpQueue ();
+    };
+
+    // Output is presized from the node count and written in a single pass; failed stays set after the first allocation error
+    struct DumpFormatter {
+        char   *data     = NULL;
+        size_t  length   = 0;
+        size_t  capacity = 0;
+        bool    failed   = false;
+    };
+
+    // Piece of the live or the free chain; step is +-1 while the slots are neighbours in memory and 0 once merged
+    struct SlotsRun {
+        ssize_t first  = 0; // First and last node in chain order
+        ssize_t last   = 0;
+        ssize_t count  = 0;
+        ssize_t step   = 0;
+        bool    isFree = false;
+    };
+
+    static DumpQueue dumpQueue = {};
+    static std::atomic <size_t> dumpCounter (0);
+
+    static DumpRequest  *CreateDumpRequest   (List *list, char *logFolder, DumpParameters *parameters, CallingFileData *callData);
+    static bool          CopyWholeList       (List *list, DumpRequest *request);
+    static bool          CopyListWindow      (List *list, DumpRequest *request);
+    static void          DestroyDumpRequest  (DumpRequest *request);
+    static void          EnqueueDumpRequest  (DumpRequest *request);
+    static bool          IsSameDumpTarget    (DumpRequest *firstRequest, DumpRequest *secondRequest);
+    static void          DumpWorker          ();
+    static void          ProcessDumpBatch    (DumpRequest **batch, size_t batchSize);
+    static ListErrorCode WriteDotFile        (DumpRequest *request);
+    static ListErrorCode WriteBinaryFile     (DumpRequest *request);
+    static void          RenderDotFiles      (DumpRequest **batch, size_t batchSize);
+
+    static bool          InitDumpFormatter    (DumpFormatter *formatter, size_t expectedLength);
+    static bool          ReserveDumpFormatter (DumpFormatter *formatter, size_t extraLength);
+    static void          FormatString         (DumpFormatter *formatter, const char *string);
+    static void          FormatIndex          (DumpFormatter *formatter, ssize_t index);
+    static void          FormatElement        (DumpFormatter *formatter, elem_t element);
+
+    static ssize_t       SnapshotIndex       (DumpRequest *request, size_t position);
+    static ssize_t       FindSnapshotNode    (DumpRequest *request, ssize_t nodeIndex);
+    static ListErrorCode DumpNode            (DumpRequest *request, size_t position, DumpFormatter *formatter);
+    static ListErrorCode DumpNodeConnections (DumpRequest *request, size_t position, DumpFormatter *formatter);
+    static ListErrorCode DumpConnection      (DumpFormatter *formatter, ssize_t from, const char *port, ssize_t to, const char *color);
+    static ListErrorCode WriteDumpHeader     (DumpRequest *request, DumpFormatter *formatter);
+    static ListErrorCode WriteHeaderFields   (DumpFormatter *formatter, const char *headName, const char *tailName, const char *freeName);
+    static ListErrorCode WriteCallData       (DumpRequest *request, DumpFormatter *formatter);
+    static ListErrorCode WriteSummary        (DumpRequest *request, DumpFormatter *formatter);
+    static size_t        CollectChainRuns    (List *list, ssize_t firstNode, bool isFree, bool *isVisited, SlotsRun *runs);
+    static void          FormatRunName       (char *nameBuffer, SlotsRun *run);
+    static ListErrorCode DumpRunConnection   (DumpFormatter *formatter, const char *fromName, const char *toName, const char *color);
+    static char         *GetLogFilename      (char *logFolder, const char *extension);
+    static ListErrorCode WriteToHtml         (DumpRequest *request);
+    static void          WriteFinishedDumps  ();
+    static void          ReportLostDumps     (size_t droppedDumps, size_t mergedDumps);
 
     ListErrorCode DumpList_ (List *list, char *logFolder, CallingFileData callData) {
         PushLog (3);
 
+        DumpParameters parameters = {};
+
+        if (list && list->capacity > MAX_FULL_DUMP_NODES) {
+            parameters.mode = SUMMARY_DUMP;
+        }
+
+        RETURN DumpListWithParameters_ (list, logFolder, parameters, callData);
+    }
+
+    ListErrorCode DumpListWithParameters_ (List *list, char *logFolder, DumpParameters parameters, CallingFileData callData) {
+        PushLog (3);
+
         ListErrorCode verificationResult = VerifyList (list);
 
         if (verificationResult & (LIST_NULL_POINTER | DATA_NULL_POINTER | PREV_NULL_POINTER | NEXT_NULL_POINTER)) {
             RETURN verificationResult;
         }
 
-        Buffer <char> graphvizBuffer = {};
-        if (InitBuffer (&graphvizBuffer, 1) != BufferErrorCode::NO_BUFFER_ERRORS) {
+        if (parameters.mode == WINDOW_DUMP && (parameters.windowCenter < 0 || parameters.windowCenter >= list->capacity)) {
+            RETURN WRONG_INDEX;
+        }
+
+        DumpRequest *request = CreateDumpRequest (list, logFolder, &parameters, &callData);
+
+        if (!request) {
             RETURN GRAPHVIZ_BUFFER_ERROR;
         }
 
-        WriteDumpHeader (list, &graphvizBuffer, &callData);
-        WriteCallData (list, &callData, &graphvizBuffer);
+        std::call_once (dumpQueue.workersStarted, [] () {
+            for (size_t workerIndex = 0; workerIndex < DUMP_WORKERS_COUNT; workerIndex++) {
+                dumpQueue.workers [workerIndex] = std::thread (DumpWorker);
+            }
+        });
 
-        for (ssize_t nodeIndex = 0; nodeIndex < list->capacity; nodeIndex++) {
-            DumpNode (list, nodeIndex, &graphvizBuffer);
+        EnqueueDumpRequest (request);
+
+        RETURN NO_LIST_ERRORS;
+    }
+
+    ListErrorCode FlushDumps () {
+        PushLog (3);
+
+        size_t droppedDumps = 0;
+        size_t mergedDumps  = 0;
+
+        {
+            std::unique_lock <std::mutex> queueLock (dumpQueue.queueMutex);
+            dumpQueue.isIdle.wait (queueLock, [] () {return dumpQueue.requests.empty () && dumpQueue.busyWorkers == 0;});
+
+            droppedDumps = dumpQueue.droppedDumps;
+            mergedDumps  = dumpQueue.mergedDumps;
+
+            dumpQueue.droppedDumps = 0;
+            dumpQueue.mergedDumps  = 0;
         }
 
-        WriteWithErrorCheck (&graphvizBuffer, "\n");
+        ReportLostDumps (droppedDumps, mergedDumps);
 
-        for (ssize_t nodeIndex = 0; nodeIndex < list->capacity; nodeIndex++) {
-            DumpNodeConnections (list, nodeIndex, &graphvizBuffer);
+        RETURN NO_LIST_ERRORS;
+    }
+
+    DumpQueue::~DumpQueue () {
+        {
+            std::lock_guard <std::mutex> queueLock (queueMutex);
+            stopWorkers = true;
+        }
+
+        hasRequests.notify_all ();
+
+        for (size_t workerIndex = 0; workerIndex < DUMP_WORKERS_COUNT; workerIndex++) {
+            if (workers [workerIndex].joinable ()) {
+                workers [workerIndex].join ();
+            }
         }
+    }
 
-        WriteWithErrorCheck (&graphvizBuffer, "}");
+    static DumpRequest *CreateDumpRequest (List *list, char *logFolder, DumpParameters *parameters, CallingFileData *callData) {
+        PushLog (4);
 
-        char *filename = GetLogFilename (logFolder);
+        DumpRequest *request = (DumpRequest *) calloc (1, sizeof (DumpRequest));
 
-        if (!filename) {
-            RETURN LOG_FILE_ERROR;
+        if (!request) {
+            RETURN NULL;
         }
 
-        FILE *logFile = fopen (filename, "w");
+        request->parameters = *parameters;
+
+        bool isCopied = parameters->mode == WINDOW_DUMP ? CopyListWindow (list, request) : CopyWholeList (list, request);
+
+        if (!isCopied) {
+            DestroyDumpRequest (request);
+            RETURN NULL;
+        }
+
+        request->snapshot.capacity     = list->capacity;
+        request->snapshot.freeElem     = list->freeElem;
+        request->snapshot.errors       = list->errors;
+        request->snapshot.creationData = list->creationData;
+        request->snapshot.generation   = list->generation;
+
+        request->head     = list->next [0];
+        request->tail     = list->prev [0];
+        request->source   = list;
+        request->callData = *callData;
+
+        strncpy (request->logFolder, logFolder, FILENAME_MAX - 1);
+
+        RETURN request;
+    }
+
+    static bool CopyWholeList (List *list, DumpRequest *request) {
+        PushLog (4);
+
+        size_t capacity = (size_t) list->capacity;
+
+        request->snapshot.data = (elem_t *)  calloc (capacity, sizeof (elem_t));
+        request->snapshot.next = (ssize_t *) calloc (capacity, sizeof (ssize_t));
+        request->snapshot.prev = (ssize_t *) calloc (capacity, sizeof (ssize_t));
+
+        if (!request->snapshot.data || !request->snapshot.next || !request->snapshot.prev) {
+            RETURN false;
+        }
+
+        memcpy (request->snapshot.data, list->data, capacity * sizeof (elem_t));
+        memcpy (request->snapshot.next, list->next, capacity * sizeof (ssize_t));
+        memcpy (request->snapshot.prev, list->prev, capacity * sizeof (ssize_t));
+
+        request->nodesCount = capacity;
+
+        RETURN true;
+    }
+
+    static bool CopyListWindow (List *list, DumpRequest *request) {
+        PushLog (4);
+
+        ssize_t center = request->parameters.windowCenter;
+        ssize_t radius = (ssize_t) std::min (request->parameters.windowRadius, (size_t) list->capacity);
+
+        // Window follows the links of the center node, so a free center gets a piece of the free list
+        ssize_t first = center;
+
+        for (ssize_t hop = 0; hop < radius && first != 0 && list->prev [first] >= 0 && list->prev [first] < list->capacity; hop++) {
+            first = list->prev [first];
+        }
+
+        size_t maxNodesCount = 2 * (size_t) radius + 1;
+
+        request->nodeIndices   = (ssize_t *) calloc (maxNodesCount, sizeof (ssize_t));
+        request->snapshot.data = (elem_t *)  calloc (maxNodesCount, sizeof (elem_t));
+        request->snapshot.next = (ssize_t *) calloc (maxNodesCount, sizeof (ssize_t));
+        request->snapshot.prev = (ssize_t *) calloc (maxNodesCount, sizeof (ssize_t));
+
+        if (!request->nodeIndices || !request->snapshot.data || !request->snapshot.next || !request->snapshot.prev) {
+            RETURN false;
+        }
+
+        bool    isCenterPassed = false;
+        ssize_t hopsAfterCenter = 0;
+
+        for (ssize_t nodeIndex = first; request->nodesCount < maxNodesCount; nodeIndex = list->next [nodeIndex]) {
+            size_t position = request->nodesCount++;
+
+            request->nodeIndices   [position] = nodeIndex;
+            request->snapshot.data [position] = list->data [nodeIndex];
+            request->snapshot.next [position] = list->next [nodeIndex];
+            request->snapshot.prev [position] = list->prev [nodeIndex];
+
+            isCenterPassed  |= nodeIndex == center;
+            hopsAfterCenter += isCenterPassed && nodeIndex != center;
+
+            if (hopsAfterCenter >= radius || list->next [nodeIndex] <= 0 || list->next [nodeIndex] >= list->capacity) {
+                break;
+            }
+        }
+
+        RETURN true;
+    }
+
+    static void DestroyDumpRequest (DumpRequest *request) {
+        if (!request) {
+            return;
+        }
+
+        free (request->snapshot.data);
+        free (request->snapshot.next);
+        free (request->snapshot.prev);
+        free (request->nodeIndices);
+        free (request->dumpFilename);
+        free (request);
+    }
+
+    static void EnqueueDumpRequest (DumpRequest *request) {
+        PushLog (4);
+
+        DumpRequest *discardedRequest = NULL;
+
+        {
+            std::lock_guard <std::mutex> queueLock (dumpQueue.queueMutex);
+
+            // A pending dump of the same list with the same parameters is replaced by the newer snapshot and keeps its place.
+            // Dumps of a list with errors are never replaced: the first one after a corruption is the useful one
+            auto mergedRequest = dumpQueue.requests.rbegin ();
+
+            while (mergedRequest != dumpQueue.requests.rend () &&
+                   (!IsSameDumpTarget (*mergedRequest, request) || (*mergedRequest)->snapshot.errors != NO_LIST_ERRORS)) {
+                mergedRequest++;
+            }
+
+            if (mergedRequest != dumpQueue.requests.rend ()) {
+                request->sequenceNumber = (*mergedRequest)->sequenceNumber;
+
+                discardedRequest = *mergedRequest;
+                *mergedRequest   = request;
+
+                dumpQueue.mergedDumps++;
+            } else if (dumpQueue.requests.size () >= MAX_PENDING_DUMPS) {
+                // Queued dumps are older and more likely to show how the list broke, so the new one goes
+                discardedRequest = request;
+
+                dumpQueue.droppedDumps++;
+            } else {
+                request->sequenceNumber = dumpQueue.nextSequenceNumber++;
+
+                dumpQueue.requests.push_back (request);
+            }
+        }
+
+        dumpQueue.hasRequests.notify_one ();
+
+        DestroyDumpRequest (discardedRequest);
+
+        RETURN;
+    }
+
+    // Same list (not just the same address: the generation changes on every InitList), same folder and same parameters
+    static bool IsSameDumpTarget (DumpRequest *firstRequest, DumpRequest *secondRequest) {
+        return firstRequest->source                  == secondRequest->source                  &&
+               firstRequest->snapshot.generation     == secondRequest->snapshot.generation     &&
+               firstRequest->parameters.mode         == secondRequest->parameters.mode         &&
+               firstRequest->parameters.windowCenter == secondRequest->parameters.windowCenter &&
+               firstRequest->parameters.windowRadius == secondRequest->parameters.windowRadius &&
+               !strcmp (firstRequest->logFolder, secondRequest->logFolder);
+    }
+
+    static void DumpWorker () {
+        DumpRequest *batch [MAX_DUMP_BATCH_SIZE] = {};
+
+        while (true) {
+            size_t batchSize = 0;
+
+            {
+                std::unique_lock <std::mutex> queueLock (dumpQueue.queueMutex);
+                dumpQueue.hasRequests.wait (queueLock, [] () {return dumpQueue.stopWorkers || !dumpQueue.requests.empty ();});
+
+                if (dumpQueue.requests.empty ()) {
+                    return;
+                }
+
+                while (batchSize < MAX_DUMP_BATCH_SIZE && !dumpQueue.requests.empty ()) {
+                    batch [batchSize++] = dumpQueue.requests.front ();
+                    dumpQueue.requests.pop_front ();
+                }
+
+                dumpQueue.busyWorkers++;
+            }
+
+            ProcessDumpBatch (batch, batchSize);
+
+            {
+                std::lock_guard <std::mutex> queueLock (dumpQueue.queueMutex);
+                dumpQueue.busyWorkers--;
+            }
+
+            dumpQueue.isIdle.notify_all ();
+        }
+    }
+
+    static void ProcessDumpBatch (DumpRequest **batch, size_t batchSize) {
+        DumpRequest *dotRequests [MAX_DUMP_BATCH_SIZE] = {};
+        size_t       dotRequestsCount = 0;
+
+        for (size_t requestIndex = 0; requestIndex < batchSize; requestIndex++) {
+            DumpRequest *request = batch [requestIndex];
+
+            ListErrorCode writeResult = request->parameters.mode == BINARY_DUMP ? WriteBinaryFile (request) : WriteDotFile (request);
+
+            request->isWritten = writeResult == NO_LIST_ERRORS;
+
+            if (request->isWritten && request->parameters.mode != BINARY_DUMP) {
+                dotRequests [dotRequestsCount++] = request;
+            }
+        }
+
+        RenderDotFiles (dotRequests, dotRequestsCount);
+
+        std::lock_guard <std::mutex> htmlLock (dumpQueue.htmlMutex);
+
+        // Failed dumps are passed on as well, otherwise the entries after them would wait forever
+        for (size_t requestIndex = 0; requestIndex < batchSize; requestIndex++) {
+            dumpQueue.finishedDumps [batch [requestIndex]->sequenceNumber] = batch [requestIndex];
+        }
+
+        WriteFinishedDumps ();
+    }
+
+    // Writes the finished dumps that continue dump.html in sequence order; htmlMutex must be held
+    static void WriteFinishedDumps () {
+        while (!dumpQueue.finishedDumps.empty () && dumpQueue.finishedDumps.begin ()->first == dumpQueue.nextHtmlSequenceNumber) {
+            DumpRequest *request = dumpQueue.finishedDumps.begin ()->second;
+
+            if (request->isWritten) {
+                WriteToHtml (request);
+            }
+
+            DestroyDumpRequest (request);
+
+            dumpQueue.finishedDumps.erase (dumpQueue.finishedDumps.begin ());
+            dumpQueue.nextHtmlSequenceNumber++;
+        }
+    }
+
+    static ListErrorCode WriteDotFile (DumpRequest *request) {
+        DumpFormatter formatter = {};
+
+        // Summary reserves its space once the runs are known
+        size_t nodesLengthEstimate = request->parameters.mode == SUMMARY_DUMP ? 0 : request->nodesCount * DUMP_NODE_LENGTH_ESTIMATE;
+
+        if (!InitDumpFormatter (&formatter, DUMP_HEADER_LENGTH_ESTIMATE + nodesLengthEstimate)) {
+            return GRAPHVIZ_BUFFER_ERROR;
+        }
+
+        WriteDumpHeader (request, &formatter);
+
+        if (request->parameters.mode == SUMMARY_DUMP) {
+            WriteSummary (request, &formatter);
+        } else {
+            for (size_t position = 0; position < request->nodesCount; position++) {
+                DumpNode (request, position, &formatter);
+            }
+
+            FormatString (&formatter, "\n");
+
+            for (size_t position = 0; position < request->nodesCount; position++) {
+                DumpNodeConnections (request, position, &formatter);
+            }
+        }
+
+        FormatString (&formatter, "}");
+
+        if (formatter.failed) {
+            free (formatter.data);
+            return GRAPHVIZ_BUFFER_ERROR;
+        }
+
+        request->dumpFilename = GetLogFilename (request->logFolder, "dot");
+
+        FILE *logFile = request->dumpFilename ? fopen (request->dumpFilename, "wx") : NULL;
         if (!logFile) {
-            free (filename);
-            RETURN LOG_FILE_ERROR;
+            free (formatter.data);
+            return LOG_FILE_ERROR;
         }
 
-        fwrite (graphvizBuffer.data, graphvizBuffer.currentIndex, sizeof (char), logFile);
+        fwrite (formatter.data, formatter.length, sizeof (char), logFile);
         fclose (logFile);
 
-        WriteToHtml (filename);
+        free (formatter.data);
+
+        return NO_LIST_ERRORS;
+    }
+
+    static ListErrorCode WriteBinaryFile (DumpRequest *request) {
+        request->dumpFilename = GetLogFilename (request->logFolder, "bin");
 
-        free (filename);
-        DestroyBuffer (&graphvizBuffer);
+        FILE *binaryFile = request->dumpFilename ? fopen (request->dumpFilename, "wbx") : NULL;
+        if (!binaryFile) {
+            return LOG_FILE_ERROR;
+        }
 
-        RETURN NO_LIST_ERRORS;
+        BinaryDumpHeader header = {};
+
+        memcpy (header.signature, BINARY_DUMP_SIGNATURE, sizeof (header.signature));
+        header.capacity = request->snapshot.capacity;
+        header.freeElem = request->snapshot.freeElem;
+
+        fwrite (&header,                 sizeof (header),  1,                   binaryFile);
+        fwrite (request->snapshot.data, sizeof (elem_t),  request->nodesCount, binaryFile);
+        fwrite (request->snapshot.next, sizeof (ssize_t), request->nodesCount, binaryFile);
+        fwrite (request->snapshot.prev, sizeof (ssize_t), request->nodesCount, binaryFile);
+
+        fclose (binaryFile);
+
+        return NO_LIST_ERRORS;
     }
 
-    static ListErrorCode WriteToHtml (char *dotFilename) {
-        PushLog (4);
+    static void RenderDotFiles (DumpRequest **batch, size_t batchSize) {
+        if (batchSize == 0) {
+            return;
+        }
+
+        // One dot process renders the whole batch, -O names every image <dot file>.svg.
+        // Filenames go to dot as separate arguments, so no shell ever parses the log folder
+        const char *renderArguments [MAX_DUMP_BATCH_SIZE + 4] = {"dot", "-Tsvg", "-O"};
+        size_t      argumentsCount = 3;
 
-        char htmlFileCommand [FILENAME_MAX * 2] = "";
-        char imageFilename   [FILENAME_MAX]     = "";
+        for (size_t requestIndex = 0; requestIndex < batchSize; requestIndex++) {
+            renderArguments [argumentsCount++] = batch [requestIndex]->dumpFilename;
+        }
 
-        snprintf (imageFilename,   FILENAME_MAX,     "%s.svg",            dotFilename);
-        snprintf (htmlFileCommand, FILENAME_MAX * 2, "dot -Tsvg %s > %s", dotFilename, imageFilename);
+        renderArguments [argumentsCount] = NULL;
 
-        system (htmlFileCommand);
+        pid_t renderProcess = fork ();
+
+        if (renderProcess == 0) {
+            execvp (renderArguments [0], (char **) renderArguments);
+            _exit (127);
+        }
 
+        if (renderProcess > 0) {
+            waitpid (renderProcess, NULL, 0);
+        }
+    }
+
+    static ListErrorCode WriteToHtml (DumpRequest *request) {
         FILE *htmlFile  = fopen (HTML_FILENAME, "a");
         if (!htmlFile) {
-            RETURN LOG_FILE_ERROR;
+            return LOG_FILE_ERROR;
+        }
+
+        if (request->parameters.mode == BINARY_DUMP) {
+            fprintf (htmlFile, "Binary snapshot of the list has been written to %s.<br>\n", request->dumpFilename);
+            fclose (htmlFile);
+
+            return NO_LIST_ERRORS;
         }
 
+        char imageFilename [FILENAME_MAX] = "";
+
+        snprintf (imageFilename, FILENAME_MAX, "%s.svg", request->dumpFilename);
+
         FILE *imageFile = fopen (imageFilename, "r");
         if (!imageFile) {
             fclose (htmlFile);
-            RETURN LOG_FILE_ERROR;
+            return LOG_FILE_ERROR;
         }
 
-        fprintf (htmlFile, "This dump has been created from file %s. List graph:", dotFilename);
+        fprintf (htmlFile, "This dump has been created from file %s. List graph:", request->dumpFilename);
 
         const int buf_size = 1024;
         char buffer[buf_size];
@@ -123,10 +579,30 @@ namespace LinkedList {
         fclose (htmlFile);
         fclose (imageFile);
 
-        RETURN NO_LIST_ERRORS;
+        return NO_LIST_ERRORS;
+    }
+
+    static void ReportLostDumps (size_t droppedDumps, size_t mergedDumps) {
+        if (droppedDumps == 0 && mergedDumps == 0) {
+            return;
+        }
+
+        std::lock_guard <std::mutex> htmlLock (dumpQueue.htmlMutex);
+
+        FILE *htmlFile = fopen (HTML_FILENAME, "a");
+        if (!htmlFile) {
+            return;
+        }
+
+        fprintf (htmlFile, "<p>%zu dumps were dropped because %zu dumps were already pending, "
+                           "%zu were replaced by a later dump of the same list.</p>\n", droppedDumps, MAX_PENDING_DUMPS, mergedDumps);
+
+        fclose (htmlFile);
     }
 
     ListErrorCode ClearHtmlFile () {
+        std::lock_guard <std::mutex> htmlLock (dumpQueue.htmlMutex);
+
         FILE *htmlFile= fopen (HTML_FILENAME, "w");
         if (!htmlFile)
             return NO_LIST_ERRORS;
@@ -135,200 +611,506 @@ namespace LinkedList {
         return NO_LIST_ERRORS;
     }
 
-    static ListErrorCode DumpNode (List *list, ssize_t nodeIndex, Buffer <char> *graphvizBuffer) {
-        PushLog (3);
+    static bool InitDumpFormatter (DumpFormatter *formatter, size_t expectedLength) {
+        formatter->data     = (char *) calloc (expectedLength, sizeof (char));
+        formatter->length   = 0;
+        formatter->capacity = expectedLength;
+        formatter->failed   = !formatter->data;
+
+        return !formatter->failed;
+    }
+
+    static bool ReserveDumpFormatter (DumpFormatter *formatter, size_t extraLength) {
+        if (formatter->failed) {
+            return false;
+        }
+
+        if (formatter->length + extraLength <= formatter->capacity) {
+            return true;
+        }
+
+        size_t newCapacity = formatter->capacity * REALLOC_SCALE;
+
+        if (newCapacity < formatter->length + extraLength) {
+            newCapacity = formatter->length + extraLength;
+        }
+
+        char *newData = (char *) realloc (formatter->data, newCapacity);
+
+        if (!newData) {
+            formatter->failed = true;
+            return false;
+        }
+
+        formatter->data     = newData;
+        formatter->capacity = newCapacity;
+
+        return true;
+    }
+
+    static void FormatString (DumpFormatter *formatter, const char *string) {
+        size_t stringLength = strlen (string);
 
-        custom_assert (list,           pointer_is_null, LIST_NULL_POINTER);
-        custom_assert (graphvizBuffer, pointer_is_null, GRAPHVIZ_BUFFER_ERROR);
+        if (!ReserveDumpFormatter (formatter, stringLength)) {
+            return;
+        }
+
+        memcpy (formatter->data + formatter->length, string, stringLength);
+        formatter->length += stringLength;
+    }
+
+    static void FormatIndex (DumpFormatter *formatter, ssize_t index) {
+        if (!ReserveDumpFormatter (formatter, MAX_INDEX_LENGTH)) {
+            return;
+        }
+
+        char   digits [MAX_INDEX_LENGTH] = "";
+        size_t digitsCount = 0;
+        size_t value       = index < 0 ? (size_t) 0 - (size_t) index : (size_t) index;
+
+        do {
+            digits [digitsCount++] = (char) ('0' + value % 10);
+            value /= 10;
+        } while (value);
+
+        if (index < 0) {
+            formatter->data [formatter->length++] = '-';
+        }
+
+        while (digitsCount > 0) {
+            formatter->data [formatter->length++] = digits [--digitsCount];
+        }
+    }
+
+    static void FormatElement (DumpFormatter *formatter, elem_t element) {
+        if (!ReserveDumpFormatter (formatter, MAX_NODE_DATA_LENGTH)) {
+            return;
+        }
+
+        int printedLength = snprintf (formatter->data + formatter->length, MAX_NODE_DATA_LENGTH, "%lf", element);
+
+        if (printedLength > 0) {
+            formatter->length += (size_t) printedLength < MAX_NODE_DATA_LENGTH ? (size_t) printedLength : MAX_NODE_DATA_LENGTH - 1;
+        }
+    }
+
+    static ssize_t SnapshotIndex (DumpRequest *request, size_t position) {
+        return request->nodeIndices ? request->nodeIndices [position] : (ssize_t) position;
+    }
+
+    static ssize_t FindSnapshotNode (DumpRequest *request, ssize_t nodeIndex) {
+        if (!request->nodeIndices) {
+            return nodeIndex >= 0 && nodeIndex < (ssize_t) request->nodesCount ? nodeIndex : -1;
+        }
+
+        for (size_t position = 0; position < request->nodesCount; position++) {
+            if (request->nodeIndices [position] == nodeIndex) {
+                return (ssize_t) position;
+            }
+        }
+
+        return -1;
+    }
 
-        char indexBuffer [MAX_INDEX_LENGTH] = "";
+    static ListErrorCode DumpNode (DumpRequest *request, size_t position, DumpFormatter *formatter) {
+        ssize_t nodeIndex = SnapshotIndex (request, position);
 
-        WriteWithErrorCheck (graphvizBuffer, "\t");
-        WriteIndexToDump    (graphvizBuffer, indexBuffer, nodeIndex);
-        WriteWithErrorCheck (graphvizBuffer, " [style=\"filled, rounded\" fillcolor=\"" DUMP_NODE_COLOR "\" shape=\"Mrecord\" color=\"");
+        FormatString (formatter, "\t");
+        FormatIndex  (formatter, nodeIndex);
+        FormatString (formatter, " [style=\"filled, rounded\" fillcolor=\"" DUMP_NODE_COLOR "\" shape=\"Mrecord\" color=\"");
 
         if (nodeIndex) {
-            if (list->prev [nodeIndex] < 0) {
-                WriteWithErrorCheck (graphvizBuffer, DUMP_FREE_NODE_OUTLINE_COLOR);
+            if (request->snapshot.prev [position] < 0) {
+                FormatString (formatter, DUMP_FREE_NODE_OUTLINE_COLOR);
             } else {
-                WriteWithErrorCheck (graphvizBuffer, DUMP_NODE_OUTLINE_COLOR);
+                FormatString (formatter, DUMP_NODE_OUTLINE_COLOR);
             }
         } else {
-            WriteWithErrorCheck (graphvizBuffer, DUMP_HEADER_NODE_COLOR);
+            FormatString (formatter, DUMP_HEADER_NODE_COLOR);
+        }
+
+        FormatString  (formatter, "\" label=\"<prev> prev: ");
+        FormatIndex   (formatter, request->snapshot.prev [position]);
+        FormatString  (formatter, " | {<index> index: ");
+        FormatIndex   (formatter, nodeIndex);
+        FormatString  (formatter, " | <data> data: ");
+        FormatElement (formatter, request->snapshot.data [position]);
+        FormatString  (formatter, "} | <next> next: ");
+        FormatIndex   (formatter, request->snapshot.next [position]);
+        FormatString  (formatter, "\"];\n");
+
+        return formatter->failed ? GRAPHVIZ_BUFFER_ERROR : NO_LIST_ERRORS;
+    }
+
+    static ListErrorCode DumpNodeConnections (DumpRequest *request, size_t position, DumpFormatter *formatter) {
+        ssize_t nodeIndex = SnapshotIndex (request, position);
+
+        if (nodeIndex == 0) {
+            return NO_LIST_ERRORS;
         }
 
-        WriteWithErrorCheck (graphvizBuffer, "\" label=\"");
+        // Window dumps are stored in link order, so a neighbour is either the adjacent snapshot entry or outside of the dump
+        bool isWindow = request->nodeIndices != NULL;
 
-        char nodeDataBuffer [MAX_NODE_DATA_LENGTH] = "";
+        // Dump next connection
 
-        snprintf (nodeDataBuffer, MAX_NODE_DATA_LENGTH, "<prev> prev: %ld | {<index> index: %ld | <data> data: %lf} | <next> next: %ld\"",
-                    list->prev [nodeIndex], nodeIndex, list->data [nodeIndex], list->next [nodeIndex]);
+        ssize_t nextIndex = request->snapshot.next [position];
 
-        WriteWithErrorCheck (graphvizBuffer, nodeDataBuffer);
+        if (nextIndex > 0 && (!isWindow || (position + 1 < request->nodesCount && request->nodeIndices [position + 1] == nextIndex))) {
+            DumpConnection (formatter, nodeIndex, "next", nextIndex, DUMP_NEXT_CONNECTION_COLOR);
+        }
 
-        WriteWithErrorCheck (graphvizBuffer, "];\n");
+        // Dump prev connection
 
-        RETURN NO_LIST_ERRORS;
+        ssize_t prevIndex = request->snapshot.prev [position];
+
+        if (prevIndex > 0 && (!isWindow || (position > 0 && request->nodeIndices [position - 1] == prevIndex))) {
+            DumpConnection (formatter, nodeIndex, "prev", prevIndex, DUMP_PREV_CONNECTION_COLOR);
+        }
+
+        return formatter->failed ? GRAPHVIZ_BUFFER_ERROR : NO_LIST_ERRORS;
     }
 
-    static ListErrorCode DumpNodeConnections (List *list, ssize_t nodeIndex, Buffer <char> *graphvizBuffer) {
-        PushLog (3);
+    static ListErrorCode DumpConnection (DumpFormatter *formatter, ssize_t from, const char *port, ssize_t to, const char *color) {
+        FormatString (formatter, "\t");
+        FormatIndex  (formatter, from);
+        FormatString (formatter, ":");
+        FormatString (formatter, port);
+        FormatString (formatter, "->");
+        FormatIndex  (formatter, to);
+        FormatString (formatter, " [color=\"");
+        FormatString (formatter, color);
+        FormatString (formatter, "\"];\n");
+
+        return formatter->failed ? GRAPHVIZ_BUFFER_ERROR : NO_LIST_ERRORS;
+    }
 
-        custom_assert (list,           pointer_is_null, LIST_NULL_POINTER);
-        custom_assert (graphvizBuffer, pointer_is_null, GRAPHVIZ_BUFFER_ERROR);
+    static ListErrorCode WriteDumpHeader (DumpRequest *request, DumpFormatter *formatter) {
+        FormatString (formatter, "digraph {\n\tbgcolor=\"" DUMP_BACKGROUND_COLOR "\";\n\tsplines=ortho\n\t");
 
-        if (nodeIndex == 0) {
-            RETURN NO_LIST_ERRORS;
+        WriteCallData (request, formatter);
+
+        // Summary mode lays out its own rows
+        if (request->parameters.mode == SUMMARY_DUMP) {
+            return formatter->failed ? GRAPHVIZ_BUFFER_ERROR : NO_LIST_ERRORS;
         }
 
-        char fromNodeDataBuffer [MAX_NODE_DATA_LENGTH] = "";
-        char toNodeDataBuffer   [MAX_NODE_DATA_LENGTH] = "";
+        if (request->nodeIndices) {
+            for (size_t position = 0; position + 1 < request->nodesCount; position++) {
+                FormatIndex  (formatter, request->nodeIndices [position]);
+                FormatString (formatter, " -> ");
+            }
 
-        // Dump next connection
+            FormatIndex (formatter, request->nodeIndices [request->nodesCount - 1]);
+        } else {
+            List   *list     = &request->snapshot;
+            ssize_t maxHops  = list->capacity;
+
+            for (ssize_t nodeIndex = list->next [0]; nodeIndex > 0 && nodeIndex < list->capacity && maxHops-- > 0; nodeIndex = list->next [nodeIndex]) {
+                FormatIndex  (formatter, nodeIndex);
+                FormatString (formatter, " -> ");
+            }
+
+            FormatString (formatter, " 0 -> ");
 
-        if (list->next [nodeIndex] > 0) {
-            snprintf (fromNodeDataBuffer, MAX_NODE_DATA_LENGTH, "%ld:next", nodeIndex);
-            snprintf (toNodeDataBuffer,   MAX_NODE_DATA_LENGTH, "%ld", list->next [nodeIndex]);
+            maxHops = list->capacity;
 
-            DumpConnection (list, graphvizBuffer, fromNodeDataBuffer, toNodeDataBuffer, DUMP_NEXT_CONNECTION_COLOR);
+            for (ssize_t nodeIndex = list->freeElem; nodeIndex > 0 && nodeIndex < list->capacity && maxHops-- > 0; nodeIndex = list->next [nodeIndex]) {
+                FormatIndex  (formatter, nodeIndex);
+                FormatString (formatter, " -> ");
+            }
+
+            FormatIndex (formatter, list->prev [0]);
         }
 
-        // Dump prev connection
+        FormatString (formatter, " [weight=999999 color=\"" DUMP_BACKGROUND_COLOR "\"; style=invis];\n");
 
-        if (list->prev [nodeIndex] <= 0) {
-            RETURN NO_LIST_ERRORS;
+        FormatString (formatter, "\t{rank=same; ");
+
+        for (size_t position = 0; position < request->nodesCount; position++) {
+            FormatIndex  (formatter, SnapshotIndex (request, position));
+            FormatString (formatter, " ");
         }
 
-        snprintf (fromNodeDataBuffer, MAX_NODE_DATA_LENGTH, "%ld:prev", nodeIndex);
-        snprintf (toNodeDataBuffer,   MAX_NODE_DATA_LENGTH, "%ld", list->prev [nodeIndex]);
+        FormatString (formatter, "}\n");
 
-        DumpConnection (list, graphvizBuffer, fromNodeDataBuffer, toNodeDataBuffer, DUMP_PREV_CONNECTION_COLOR);
+        char headName [MAX_INDEX_LENGTH] = "";
+        char tailName [MAX_INDEX_LENGTH] = "";
+        char freeName [MAX_INDEX_LENGTH] = "";
 
-        RETURN NO_LIST_ERRORS;
+        // Pointers leading out of a window are not drawn
+        if (FindSnapshotNode (request, request->head) >= 0) {
+            snprintf (headName, MAX_INDEX_LENGTH, "%zd", request->head);
+        }
+
+        if (FindSnapshotNode (request, request->tail) >= 0) {
+            snprintf (tailName, MAX_INDEX_LENGTH, "%zd", request->tail);
+        }
+
+        if (FindSnapshotNode (request, request->snapshot.freeElem) >= 0) {
+            snprintf (freeName, MAX_INDEX_LENGTH, "%zd", request->snapshot.freeElem);
+        }
+
+        return WriteHeaderFields (formatter, headName, tailName, freeName);
     }
 
-    static ListErrorCode DumpConnection (List *list, Buffer <char> *graphvizBuffer, const char *from, const char *to, const char *color) {
-        PushLog (3);
+    static ListErrorCode WriteHeaderFields (DumpFormatter *formatter, const char *headName, const char *tailName, const char *freeName) {
+        const char *HeaderFieldStyle      = "[style=\"filled, rounded\" fillcolor=\"" DUMP_NODE_COLOR"\" shape=\"rectangle\" color = \"" DUMP_HEADER_NODE_COLOR "\"];\n";
+        const char *HeaderConnectionStyle = "[color=\"" DUMP_HEADER_NODE_COLOR "\"];\n";
 
-        WriteWithErrorCheck (graphvizBuffer, "\t");
-        WriteWithErrorCheck (graphvizBuffer, from);
-        WriteWithErrorCheck (graphvizBuffer, "->");
-        WriteWithErrorCheck (graphvizBuffer, to);
-        WriteWithErrorCheck (graphvizBuffer, " [color=\"");
-        WriteWithErrorCheck (graphvizBuffer, color);
-        WriteWithErrorCheck (graphvizBuffer, "\"];\n");
+        const char *fieldNames   [] = {"Head",   "Tail",   "Free"};
+        const char *fieldTargets [] = {headName, tailName, freeName};
 
-        RETURN NO_LIST_ERRORS;
+        for (size_t fieldIndex = 0; fieldIndex < sizeof (fieldNames) / sizeof (*fieldNames); fieldIndex++) {
+            FormatString (formatter, "\t");
+            FormatString (formatter, fieldNames [fieldIndex]);
+            FormatString (formatter, HeaderFieldStyle);
+
+            if (!*fieldTargets [fieldIndex]) {
+                continue;
+            }
+
+            FormatString (formatter, "\t");
+            FormatString (formatter, fieldNames [fieldIndex]);
+            FormatString (formatter, " -> ");
+            FormatString (formatter, fieldTargets [fieldIndex]);
+            FormatString (formatter, HeaderConnectionStyle);
+        }
+
+        return formatter->failed ? GRAPHVIZ_BUFFER_ERROR : NO_LIST_ERRORS;
     }
 
-    static ListErrorCode WriteDumpHeader (List *list, Buffer <char> *graphvizBuffer, CallingFileData *callData) {
-        PushLog (4);
+    static ListErrorCode WriteCallData (DumpRequest *request, DumpFormatter *formatter) {
+        CallingFileData *creationData = &request->snapshot.creationData;
+        CallingFileData *callData     = &request->callData;
+
+        FormatString (formatter, "\tCreation [shape=rectangle style=filled fillcolor=\"" DUMP_NODE_COLOR "\" rank=max label=\"Was created in ");
+        FormatString (formatter, creationData->function ? creationData->function : "(null)");
+        FormatString (formatter, " (");
+        FormatString (formatter, creationData->file ? creationData->file : "(null)");
+        FormatString (formatter, ":");
+        FormatIndex  (formatter, creationData->line);
+        FormatString (formatter, ")\"]\n");
+
+        FormatString (formatter, "\tCall [shape=rectangle style=filled fillcolor=\"" DUMP_NODE_COLOR "\" rank=max label=\"Was called in ");
+        FormatString (formatter, callData->function ? callData->function : "(null)");
+        FormatString (formatter, " (");
+        FormatString (formatter, callData->file ? callData->file : "(null)");
+        FormatString (formatter, ":");
+        FormatIndex  (formatter, callData->line);
+        FormatString (formatter, ")\"]\n");
+
+        return formatter->failed ? GRAPHVIZ_BUFFER_ERROR : NO_LIST_ERRORS;
+    }
+
+    static ListErrorCode WriteSummary (DumpRequest *request, DumpFormatter *formatter) {
+        List *list = &request->snapshot;
+
+        SlotsRun *runs      = (SlotsRun *) calloc ((size_t) list->capacity, sizeof (SlotsRun));
+        bool     *isVisited = (bool *)     calloc ((size_t) list->capacity, sizeof (bool));
+
+        if (!runs || !isVisited) {
+            free (runs);
+            free (isVisited);
+
+            formatter->failed = true;
+            return GRAPHVIZ_BUFFER_ERROR;
+        }
+
+        isVisited [0] = true;
+
+        size_t liveRunsCount = CollectChainRuns (list, list->next [0], false, isVisited, runs);
+        size_t freeRunsCount = CollectChainRuns (list, list->freeElem, true,  isVisited, runs + liveRunsCount);
+        size_t runsCount     = liveRunsCount + freeRunsCount;
 
-        custom_assert (graphvizBuffer, pointer_is_null, GRAPHVIZ_BUFFER_ERROR);
+        // Slots reached by neither chain only exist in a broken list
+        ssize_t orphansCount = 0;
 
-        WriteWithErrorCheck (graphvizBuffer, "digraph {\n\tbgcolor=\"" DUMP_BACKGROUND_COLOR "\";\n\tsplines=ortho\n\t");
+        for (ssize_t nodeIndex = 1; nodeIndex < list->capacity; nodeIndex++) {
+            orphansCount += !isVisited [nodeIndex];
+        }
+
+        free (isVisited);
+
+        ReserveDumpFormatter (formatter, (runsCount + 2) * DUMP_NODE_LENGTH_ESTIMATE);
+
+        char runName  [MAX_NODE_DATA_LENGTH] = "";
+        char nextName [MAX_NODE_DATA_LENGTH] = "";
+
+        // Header node and single slot runs keep the full record, longer runs become one node each
+        DumpNode (request, 0, formatter);
 
-        WriteCallData (list, callData, graphvizBuffer);
+        for (size_t runIndex = 0; runIndex < runsCount; runIndex++) {
+            SlotsRun *run = &runs [runIndex];
 
-        char indexBuffer [MAX_INDEX_LENGTH] = "";
+            if (run->count == 1) {
+                DumpNode (request, (size_t) run->first, formatter);
+                continue;
+            }
+
+            FormatString (formatter, "\trun");
+            FormatIndex  (formatter, run->first);
+            FormatString (formatter, " [style=\"filled, rounded\" fillcolor=\"" DUMP_NODE_COLOR "\" shape=\"Mrecord\" color=\"");
+            FormatString (formatter, run->isFree ? DUMP_FREE_NODE_OUTLINE_COLOR : DUMP_NODE_OUTLINE_COLOR);
+            FormatString (formatter, run->isFree ? "\" label=\"free " : "\" label=\"live ");
+            FormatString (formatter, run->step != 0 ? "slots " : "scattered nodes ");
+            FormatIndex  (formatter, run->first);
+            FormatString (formatter, run->step != 0 ? " - " : " ... ");
+            FormatIndex  (formatter, run->last);
+            FormatString (formatter, " | count: ");
+            FormatIndex  (formatter, run->count);
+            FormatString (formatter, "\"];\n");
+        }
 
-        // TODO separate function
-        for (ssize_t nodeIndex = list->next [0]; nodeIndex > 0 && nodeIndex < list->capacity; nodeIndex = list->next [nodeIndex]) {
-            WriteIndexToDump    (graphvizBuffer, indexBuffer, nodeIndex);
-            WriteWithErrorCheck (graphvizBuffer, " -> ");
+        if (orphansCount > 0) {
+            FormatString (formatter, "\tOrphans [style=\"filled, rounded\" fillcolor=\"" DUMP_NODE_COLOR "\" shape=\"Mrecord\" "
+                                     "color=\"" DUMP_NODE_OUTLINE_COLOR "\" label=\"unreachable slots | count: ");
+            FormatIndex  (formatter, orphansCount);
+            FormatString (formatter, "\"];\n");
         }
 
-        WriteWithErrorCheck (graphvizBuffer, " 0 -> ");
+        FormatString (formatter, "\n");
+
+        // Links between neighbouring runs of a chain; the free chain has no prev links
+        for (size_t runIndex = 0; runIndex + 1 < runsCount; runIndex++) {
+            if (runIndex + 1 == liveRunsCount) {
+                continue;
+            }
+
+            FormatRunName (runName,  &runs [runIndex]);
+            FormatRunName (nextName, &runs [runIndex + 1]);
+
+            DumpRunConnection (formatter, runName, nextName, DUMP_NEXT_CONNECTION_COLOR);
 
-        for (ssize_t nodeIndex = list->freeElem; nodeIndex > 0 && nodeIndex < list->capacity; nodeIndex = list->next [nodeIndex]) {
-            WriteIndexToDump    (graphvizBuffer, indexBuffer, nodeIndex);
-            WriteWithErrorCheck (graphvizBuffer, " -> ");
+            if (runIndex + 1 < liveRunsCount) {
+                DumpRunConnection (formatter, nextName, runName, DUMP_PREV_CONNECTION_COLOR);
+            }
         }
 
-        WriteIndexToDump    (graphvizBuffer, indexBuffer, list->prev [0]);
-        WriteWithErrorCheck (graphvizBuffer, " [weight=999999 color=\"" DUMP_BACKGROUND_COLOR "\"; style=invis];\n");
+        FormatString (formatter, "\t0");
 
-        WriteWithErrorCheck (graphvizBuffer, "\t{rank=same; ");
+        for (size_t runIndex = 0; runIndex < runsCount; runIndex++) {
+            FormatRunName (runName, &runs [runIndex]);
 
-        for (ssize_t nodeIndex = 0; nodeIndex < list->capacity; nodeIndex++) {
-            WriteIndexToDump    (graphvizBuffer, indexBuffer, nodeIndex);
-            WriteWithErrorCheck (graphvizBuffer, " ");
+            FormatString (formatter, " -> ");
+            FormatString (formatter, runName);
         }
 
-        WriteWithErrorCheck (graphvizBuffer, "}\n");
+        FormatString (formatter, " [weight=999999 color=\"" DUMP_BACKGROUND_COLOR "\"; style=invis];\n");
 
-        // TODO looks like lots of copy-pase
-        const char *HeaderFieldStyle = "[style=\"filled, rounded\" fillcolor=\"" DUMP_NODE_COLOR"\" shape=\"rectangle\" color = \"" DUMP_HEADER_NODE_COLOR "\"];\n";
+        FormatString (formatter, "\t{rank=same; 0 ");
 
-        WriteWithErrorCheck (graphvizBuffer, "\tHead");
-        WriteWithErrorCheck (graphvizBuffer, HeaderFieldStyle);
+        for (size_t runIndex = 0; runIndex < runsCount; runIndex++) {
+            FormatRunName (runName, &runs [runIndex]);
 
-        WriteWithErrorCheck (graphvizBuffer, "\tTail");
-        WriteWithErrorCheck (graphvizBuffer, HeaderFieldStyle);
+            FormatString (formatter, runName);
+            FormatString (formatter, " ");
+        }
 
-        WriteWithErrorCheck (graphvizBuffer, "\tFree");
-        WriteWithErrorCheck (graphvizBuffer, HeaderFieldStyle);
+        FormatString (formatter, "}\n");
 
-        const char *HeaderConnectionStyle = "[color=\"" DUMP_HEADER_NODE_COLOR "\"];\n";
+        char headName [MAX_NODE_DATA_LENGTH] = "";
+        char tailName [MAX_NODE_DATA_LENGTH] = "";
+        char freeName [MAX_NODE_DATA_LENGTH] = "";
 
-        WriteWithErrorCheck (graphvizBuffer, "\tHead -> ");
-        WriteIndexToDump    (graphvizBuffer, indexBuffer, list->next [0]);
-        WriteWithErrorCheck (graphvizBuffer, HeaderConnectionStyle);
+        if (liveRunsCount > 0) {
+            FormatRunName (headName, &runs [0]);
 
+            if (runs [liveRunsCount - 1].last == request->tail) {
+                FormatRunName (tailName, &runs [liveRunsCount - 1]);
+            }
+        }
 
-        WriteWithErrorCheck (graphvizBuffer, "\tTail -> ");
-        WriteIndexToDump    (graphvizBuffer, indexBuffer, list->prev [0]);
-        WriteWithErrorCheck (graphvizBuffer, HeaderConnectionStyle);
+        if (freeRunsCount > 0) {
+            FormatRunName (freeName, &runs [liveRunsCount]);
+        }
 
-        WriteWithErrorCheck (graphvizBuffer, "\tFree -> ");
-        WriteIndexToDump    (graphvizBuffer, indexBuffer, list->freeElem);
-        WriteWithErrorCheck (graphvizBuffer, HeaderConnectionStyle);
+        free (runs);
 
-        RETURN NO_LIST_ERRORS;
+        return WriteHeaderFields (formatter, headName, tailName, freeName);
     }
 
-    static ListErrorCode WriteCallData (List *list, CallingFileData *callData, Buffer <char> *graphvizBuffer) {
-        PushLog (4);
+    // Follows a chain from its first node and collapses it into runs of neighbouring slots. A visited or invalid
+    // index ends the chain, so a broken list can't loop. Chains longer than MAX_SUMMARY_RUNS runs get their
+    // neighbouring runs merged into scattered ones
+    static size_t CollectChainRuns (List *list, ssize_t firstNode, bool isFree, bool *isVisited, SlotsRun *runs) {
+        size_t runsCount = 0;
 
-        char callDataBuffer [FILENAME_MAX] = "";
+        for (ssize_t nodeIndex = firstNode; nodeIndex > 0 && nodeIndex < list->capacity && !isVisited [nodeIndex];
+             nodeIndex = list->next [nodeIndex]) {
 
-        WriteWithErrorCheck (graphvizBuffer, "\tCreation [shape=rectangle style=filled fillcolor=\"" DUMP_NODE_COLOR "\" rank=max label=\"Was created in ");
-        snprintf (callDataBuffer, FILENAME_MAX, "%s (%s:%d)",
-                    list->creationData.function, list->creationData.file, list->creationData.line);
-        WriteWithErrorCheck (graphvizBuffer, callDataBuffer);
-        WriteWithErrorCheck (graphvizBuffer, "\"]\n");
+            isVisited [nodeIndex] = true;
 
-        WriteWithErrorCheck (graphvizBuffer, "\tCall [shape=rectangle style=filled fillcolor=\"" DUMP_NODE_COLOR "\" rank=max label=\"Was called in ");
-        snprintf (callDataBuffer, FILENAME_MAX, "%s (%s:%d)",
-                    callData->function, callData->file, callData->line);
-        WriteWithErrorCheck (graphvizBuffer, callDataBuffer);
-        WriteWithErrorCheck (graphvizBuffer, "\"]\n");
+            SlotsRun *lastRun = runsCount > 0 ? &runs [runsCount - 1] : NULL;
+            ssize_t   step    = lastRun ? nodeIndex - lastRun->last : 0;
 
-        RETURN NO_LIST_ERRORS;
+            if (lastRun && (step == 1 || step == -1) && (lastRun->count == 1 || lastRun->step == step)) {
+                lastRun->last = nodeIndex;
+                lastRun->step = step;
+                lastRun->count++;
+            } else {
+                runs [runsCount++] = {nodeIndex, nodeIndex, 1, 0, isFree};
+            }
+        }
+
+        if (runsCount <= MAX_SUMMARY_RUNS) {
+            return runsCount;
+        }
+
+        size_t groupSize   = (runsCount + MAX_SUMMARY_RUNS - 1) / MAX_SUMMARY_RUNS;
+        size_t groupsCount = 0;
+
+        for (size_t groupFirst = 0; groupFirst < runsCount; groupFirst += groupSize) {
+            size_t   groupEnd = groupFirst + groupSize < runsCount ? groupFirst + groupSize : runsCount;
+            SlotsRun group    = runs [groupFirst];
+
+            for (size_t runIndex = groupFirst + 1; runIndex < groupEnd; runIndex++) {
+                group.last   = runs [runIndex].last;
+                group.count += runs [runIndex].count;
+                group.step   = 0;
+            }
+
+            runs [groupsCount++] = group;
+        }
+
+        return groupsCount;
     }
 
-    static char *GetLogFilename (char *logFolder) {
-        PushLog (4);
+    static void FormatRunName (char *nameBuffer, SlotsRun *run) {
+        snprintf (nameBuffer, MAX_NODE_DATA_LENGTH, run->count == 1 ? "%zd" : "run%zd", run->first);
+    }
 
+    static ListErrorCode DumpRunConnection (DumpFormatter *formatter, const char *fromName, const char *toName, const char *color) {
+        FormatString (formatter, "\t");
+        FormatString (formatter, fromName);
+        FormatString (formatter, "->");
+        FormatString (formatter, toName);
+        FormatString (formatter, " [color=\"");
+        FormatString (formatter, color);
+        FormatString (formatter, "\"];\n");
+
+        return formatter->failed ? GRAPHVIZ_BUFFER_ERROR : NO_LIST_ERRORS;
+    }
+
+    static char *GetLogFilename (char *logFolder, const char *extension) {
         time_t currentTime = time (NULL);
-        tm localTime = *localtime (&currentTime);
+        tm localTime = {};
+        localtime_r (&currentTime, &localTime);
 
         char *filename = (char *) calloc (FILENAME_MAX, sizeof (char));
 
         if (!filename) {
-            RETURN NULL;
+            return NULL;
         }
 
-        int versionCounter = 0;
-
         do {
-            snprintf (filename, FILENAME_MAX, "%s/%.2d-%.2d-%.4d_%.2d:%.2d:%.2d_%d.dot", logFolder, localTime.tm_mday, localTime.tm_mon,
-                        localTime.tm_year + 1900, localTime.tm_hour, localTime.tm_min, localTime.tm_sec, versionCounter);
+            size_t versionCounter = dumpCounter++;
 
-            versionCounter++;
+            snprintf (filename, FILENAME_MAX, "%s/%.2d-%.2d-%.4d_%.2d:%.2d:%.2d_%zu.%s", logFolder, localTime.tm_mday, localTime.tm_mon,
+                        localTime.tm_year + 1900, localTime.tm_hour, localTime.tm_min, localTime.tm_sec, versionCounter, extension);
         }  while (!access (filename, F_OK));
 
-        RETURN filename;
+        return filename;
     }
 
 }
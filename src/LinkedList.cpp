@@ -1,3 +1,4 @@
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -27,6 +28,7 @@
     )
 
 namespace LinkedList {
+    static std::atomic <size_t> listGenerationCounter (0);
 
     ListErrorCode InitList_ (List *list, size_t capacity, CallingFileData creationData) {
         PushLog (3);
@@ -60,6 +62,7 @@ namespace LinkedList {
         }
 
         list->creationData = creationData;
+        list->generation   = ++listGenerationCounter;
 
         Verification (list, creationData);
 
@@ -23,5 +23,7 @@ int main () {
 
     LinkedList::DestroyList (&list);
 
+    LinkedList::FlushDumps ();
+
     RETURN 0;
 }